@@ -4,6 +4,7 @@
 #include "SettingsSync.h"
 #include "DefaultPacks.h"
 #include "PackUsageTracker.h"
+#include "TrainingPackManager.h"
 
 #include <algorithm>
 #include <random>
@@ -11,8 +12,9 @@
 void AutoLoadFeature::OnMatchEnded(std::shared_ptr<GameWrapper> gameWrapper,
                                    std::shared_ptr<CVarManagerWrapper> cvarManager,
                                    const std::vector<MapEntry>& maps,
-                                   const std::vector<TrainingEntry>& training,
+                                   const TrainingPackManager* training,
                                    const std::vector<WorkshopEntry>& workshop,
+                                   bool workshopListReady,
                                    bool useBagRotation,
                                    const TrainingEntry& selectedBagPack,
                                    SettingsSync& settings,
@@ -77,10 +79,9 @@ void AutoLoadFeature::OnMatchEnded(std::shared_ptr<GameWrapper> gameWrapper,
             codeToLoad = targetCode;
 
             // Try to find name in cache for logging, but don't require it
-            auto it = std::find_if(training.begin(), training.end(),
-                [&](const TrainingEntry& e) { return e.code == targetCode; });
-            if (it != training.end()) {
-                nameToLoad = it->name;
+            const PackRef pack = training ? training->FindPack(targetCode) : PackRef{};
+            if (pack) {
+                nameToLoad = pack->name;
             } else {
                 nameToLoad = targetCode; // Use code as name if not in cache
             }
@@ -99,11 +100,10 @@ void AutoLoadFeature::OnMatchEnded(std::shared_ptr<GameWrapper> gameWrapper,
 
             if (!quickPicks.empty()) {
                 std::string fallbackCode = quickPicks[0];
-                auto it = std::find_if(training.begin(), training.end(),
-                    [&](const TrainingEntry& e) { return e.code == fallbackCode; });
-                
+                const PackRef pack = training ? training->FindPack(fallbackCode) : PackRef{};
+
                 codeToLoad = fallbackCode;
-                nameToLoad = (it != training.end()) ? it->name : "Quick Pick Fallback";
+                nameToLoad = pack ? pack->name : "Quick Pick Fallback";
                 LOG("SuiteSpot: Selected pack missing, falling back to first Quick Pick: {}", nameToLoad);
             }
         }
@@ -124,6 +124,11 @@ void AutoLoadFeature::OnMatchEnded(std::shared_ptr<GameWrapper> gameWrapper,
 
         if (currentWorkshopPath.empty()) {
             LOG("SuiteSpot: ⚠️ No workshop map selected; skipping load.");
+        } else if (!workshopListReady) {
+            // Can't verify against a list that's still being scanned; trust the saved path
+            safeExecute(delayWorkshopSec, "load_workshop \"" + currentWorkshopPath + "\"");
+            mapLoadDelay = delayWorkshopSec;
+            LOG("SuiteSpot: Workshop scan still running; loading saved map: {}", currentWorkshopPath);
         } else {
             // Verify the workshop map exists in the list
             auto it = std::find_if(workshop.begin(), workshop.end(),
@@ -29,6 +29,7 @@
  */
 
 class PackUsageTracker;
+class TrainingPackManager;
 
 class AutoLoadFeature
 {
@@ -36,11 +37,14 @@ public:
     // The main entry point. Called when the match ends.
     // It takes ALL the necessary data (settings, map lists) and decides what to do.
     // For training mode: if useBagRotation is true, selectedBagPack contains the pre-selected pack
+    // workshopListReady is false while the startup scan is still running; the saved path is then
+    // loaded without checking it against the (not yet filled) list.
     void OnMatchEnded(std::shared_ptr<GameWrapper> gameWrapper,
         std::shared_ptr<CVarManagerWrapper> cvarManager,
         const std::vector<MapEntry>& freeplayMaps,
-        const std::vector<TrainingEntry>& trainingPacks,
+        const TrainingPackManager* trainingPacks,  // Name lookups only; may be null
         const std::vector<WorkshopEntry>& workshopMaps,
+        bool workshopListReady,
         bool useBagRotation,
         const TrainingEntry& selectedBagPack,
         SettingsSync& settings,
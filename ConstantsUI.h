@@ -229,15 +229,6 @@ namespace UI {
 		// Expected character length for properly formatted training pack code
 		constexpr int PACK_CODE_EXPECTED_LENGTH = 19;
 
-		// Position of first dash in training pack code (0-indexed)
-		constexpr int PACK_CODE_DASH_POSITION_1 = 4;
-
-		// Position of second dash in training pack code (0-indexed)
-		constexpr int PACK_CODE_DASH_POSITION_2 = 9;
-
-		// Position of third dash in training pack code (0-indexed)
-		constexpr int PACK_CODE_DASH_POSITION_3 = 14;
-
 		// Maximum characters allowed for raw pack code before formatting
 		constexpr int PACK_CODE_RAW_MAX_LENGTH = 16;
 
@@ -48,4 +48,22 @@ struct WorkshopEntry {
     std::shared_ptr<ImageWrapper> previewImage;  // Loaded image
     bool isImageLoaded = false;
 };
-extern std::vector<WorkshopEntry> RLWorkshop;
\ No newline at end of file
+extern std::vector<WorkshopEntry> RLWorkshop;
+
+// Progress of a list that is loaded in the background (pack catalog, workshop scan).
+// While Loading, readers keep using whatever list was published last.
+enum class CatalogLoadState {
+    Idle,       // Nothing requested yet
+    Loading,    // Worker thread is reading
+    Ready,      // Latest load was published
+    Failed      // Latest load failed; the previous list is still in place
+};
+
+enum class PackUpdateState {
+    Idle,       // No update this session
+    Fetching,   // Downloading pages
+    Merging,    // Writing the pack file and patching the catalog
+    Done,       // Latest update finished (possibly with nothing new)
+    Failed,     // Latest update failed or came back incomplete; the list is unchanged
+    Cancelled   // Latest update was cancelled; the list is unchanged
+};
\ No newline at end of file
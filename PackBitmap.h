@@ -0,0 +1,138 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * ======================================================================================
+ * PACK BITMAP: ONE BIT PER PACK
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * A yes/no flag for every catalog row, packed 64 rows to a word. "Is this pack
+ * Diamond?", "Does it have the Aerials tag?", "Does it have a video?" each get one.
+ *
+ * WHY IS IT HERE?
+ * Combining filters becomes word-wide AND/OR (64 packs per instruction, and the simple
+ * loops vectorize further), and "how many packs match?" is a popcount.
+ *
+ * HOW DOES IT WORK?
+ * Bit `r` lives in word `r / 64`. Bits past `size()` are always kept at zero so
+ * `Count()` and the combine operators never see garbage. `InsertBit()` / `EraseBit()`
+ * shift the higher rows along, mirroring an insert/erase in the pack vector.
+ */
+
+class PackBitmap
+{
+public:
+    PackBitmap() = default;
+    explicit PackBitmap(size_t bitCount, bool value = false) { Reset(bitCount, value); }
+
+    void Reset(size_t bitCount, bool value = false)
+    {
+        count = bitCount;
+        words.assign((bitCount + 63) / 64, value ? ~uint64_t{0} : 0);
+        ClearTail();
+    }
+
+    size_t size() const { return count; }
+
+    bool Test(int row) const { return (words[row >> 6] >> (row & 63)) & 1u; }
+
+    void Set(int row, bool value = true)
+    {
+        const uint64_t mask = uint64_t{1} << (row & 63);
+        words[row >> 6] = value ? (words[row >> 6] | mask) : (words[row >> 6] & ~mask);
+    }
+
+    // Shift bits [row, size()) up by one and put `value` in the gap
+    void InsertBit(int row, bool value)
+    {
+        if (words.size() * 64 < count + 1) {
+            words.push_back(0);
+        }
+
+        const size_t first = static_cast<size_t>(row) >> 6;
+        for (size_t w = words.size() - 1; w > first; --w) {
+            words[w] = (words[w] << 1) | (words[w - 1] >> 63);
+        }
+
+        const uint64_t lowMask = (uint64_t{1} << (row & 63)) - 1;
+        const uint64_t word = words[first];
+        words[first] = (word & lowMask) | ((word & ~lowMask) << 1) |
+                       (static_cast<uint64_t>(value) << (row & 63));
+        ++count;
+    }
+
+    // Remove bit `row` and shift everything above it down by one
+    void EraseBit(int row)
+    {
+        const size_t first = static_cast<size_t>(row) >> 6;
+        const uint64_t lowMask = (uint64_t{1} << (row & 63)) - 1;
+        const uint64_t word = words[first];
+        words[first] = (word & lowMask) | ((word >> 1) & ~lowMask);
+
+        for (size_t w = first; w + 1 < words.size(); ++w) {
+            words[w] |= (words[w + 1] & 1) << 63;
+            words[w + 1] >>= 1;
+        }
+
+        --count;
+        if (words.size() > (count + 63) / 64) {
+            words.pop_back();
+        }
+    }
+
+    PackBitmap& operator&=(const PackBitmap& other)
+    {
+        for (size_t w = 0; w < words.size(); ++w) words[w] &= other.words[w];
+        return *this;
+    }
+
+    PackBitmap& operator|=(const PackBitmap& other)
+    {
+        for (size_t w = 0; w < words.size(); ++w) words[w] |= other.words[w];
+        return *this;
+    }
+
+    size_t Count() const
+    {
+        size_t total = 0;
+        for (uint64_t word : words) total += std::popcount(word);
+        return total;
+    }
+
+    // Popcount of (this & other) without building the intersection
+    size_t CountAnd(const PackBitmap& other) const
+    {
+        size_t total = 0;
+        for (size_t w = 0; w < words.size(); ++w) total += std::popcount(words[w] & other.words[w]);
+        return total;
+    }
+
+    // Calls fn(row) for every set bit, in ascending row order
+    template <typename Fn>
+    void ForEach(Fn&& fn) const
+    {
+        for (size_t w = 0; w < words.size(); ++w) {
+            for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+                fn(static_cast<int>(w * 64 + std::countr_zero(bits)));
+            }
+        }
+    }
+
+    std::vector<uint64_t>& Words() { return words; }
+    const std::vector<uint64_t>& Words() const { return words; }
+
+private:
+    void ClearTail()
+    {
+        if (count & 63) {
+            words.back() &= (uint64_t{1} << (count & 63)) - 1;
+        }
+    }
+
+    std::vector<uint64_t> words;
+    size_t count = 0;
+};
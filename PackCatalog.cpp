@@ -0,0 +1,49 @@
+#include "pch.h"
+#include "PackCatalog.h"
+
+void PackCatalog::BuildIndexes()
+{
+    searchIndex.Build(packs);
+    codeIndex.Build(packs);
+    columns.Build(packs);
+    sortIndex.Build(columns);
+}
+
+int PackCatalog::Insert(const TrainingEntry& pack)
+{
+    const int row = columns.NameUpperBound(PackColumns::FoldKey(pack.name));
+    packs.insert(packs.begin() + row, pack);
+    searchIndex.InsertRow(row, packs[row]);
+    codeIndex.InsertRow(row, packs[row].code);
+    columns.InsertRow(row, packs[row]);
+    sortIndex.InsertRow(row, columns);
+    return row;
+}
+
+void PackCatalog::Erase(int row)
+{
+    searchIndex.EraseRow(row);
+    codeIndex.EraseRow(row, packs[row].code);
+    columns.EraseRow(row);
+    sortIndex.EraseRow(row, columns);
+    packs.erase(packs.begin() + row);
+}
+
+int PackCatalog::Replace(int row, const TrainingEntry& pack)
+{
+    // Only the shot count changed: patch the one column instead of re-indexing the row
+    const TrainingEntry& old = packs[row];
+    if (old.name == pack.name && old.code == pack.code && old.creator == pack.creator &&
+        old.difficulty == pack.difficulty && old.tags == pack.tags && old.videoUrl == pack.videoUrl &&
+        old.likes == pack.likes && old.plays == pack.plays) {
+        if (old.shotCount != pack.shotCount) {
+            columns.SetShots(row, pack.shotCount);
+            sortIndex.UpdateRow(PackSortIndex::Shots, row, columns);
+        }
+        packs[row] = pack;
+        return row;
+    }
+
+    Erase(row);
+    return Insert(pack);
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "MapList.h"
+#include "PackCodeIndex.h"
+#include "PackColumns.h"
+#include "PackSearchIndex.h"
+#include "PackSortIndex.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * ======================================================================================
+ * PACK CATALOG: ONE FROZEN VERSION OF THE PACK LIST
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * The training pack list together with every index built over it (search, code, columns,
+ * sort order) and the "last updated" date, bundled as one value.
+ *
+ * WHY IS IT HERE?
+ * The browser, quick picks and post-match loader read the pack list from the render and
+ * hook threads while the scraper/loader threads replace it. With the list and its indexes
+ * held separately behind one mutex, every reader had to lock, and a search held that lock
+ * for the whole filter and sort. A catalog that never changes after it's published can be
+ * read by any number of threads with no lock at all.
+ *
+ * HOW DOES IT WORK?
+ * 1. TrainingPackManager publishes a `std::shared_ptr<const PackCatalog>` through an
+ *    atomic. Readers load it once and keep using that version for as long as they hold it.
+ * 2. A change never edits the published catalog. The writer copies it, edits the copy with
+ *    `Insert()` / `Erase()` / `Replace()` (which keep every index aligned), and publishes
+ *    the copy. Readers holding the old version are unaffected; it's freed when the last
+ *    one lets go.
+ * 3. A full load builds a brand-new catalog on the worker thread and calls `BuildIndexes()`
+ *    there, so publishing is just the pointer swap.
+ * 4. Every published catalog gets a higher `version` than the one before. UI caches keep the
+ *    version they were built from and rebuild only when it changes (edits and heals included,
+ *    which a pack count comparison would miss).
+ */
+
+struct PackCatalog
+{
+    std::vector<TrainingEntry> packs;  // Sorted by name; rows in every index point in here
+    PackSearchIndex searchIndex;       // Name trigrams + numeric codes
+    PackCodeIndex codeIndex;           // Code -> row
+    PackColumns columns;               // Filter/sort fields, one array per field
+    PackSortIndex sortIndex;           // Rows pre-sorted by each browser column
+    std::string lastUpdated = "Never";
+    uint64_t version = 0;              // Stamped by the manager on publish; goes up with every change
+
+    // Rebuilds every index from `packs` (after a load)
+    void BuildIndexes();
+
+    // Adds `pack` at its alphabetical position and returns its row
+    int Insert(const TrainingEntry& pack);
+    void Erase(int row);
+
+    // Swaps in `pack` for the one at `row`. The row moves if the name changed.
+    int Replace(int row, const TrainingEntry& pack);
+};
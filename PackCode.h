@@ -0,0 +1,127 @@
+#pragma once
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+/*
+ * ======================================================================================
+ * PACK CODE: A TRAINING PACK CODE AS ONE NUMBER
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * A training pack code like "CE79-F64D-344F-5F1E" is 16 hexadecimal digits, which is
+ * exactly one 64-bit number. `PackCode` stores it that way.
+ *
+ * WHY IS IT HERE?
+ * As text, every code is a heap string, comparing two codes is a string compare, and
+ * "ce79f64d344f5f1e" and "CE79-F64D-344F-5F1E" count as different codes. As a number it's
+ * 8 bytes, compares and hashes as one integer, and every spelling of a code is the same.
+ *
+ * HOW DOES IT WORK?
+ * 1. `Parse()` accepts upper/lower case and ignores dashes and spaces; anything that isn't
+ *    exactly 16 hex digits is rejected.
+ * 2. `ToString()` always gives the canonical "XXXX-XXXX-XXXX-XXXX" form back.
+ * 3. Each hex digit is 4 bits, first digit highest. So "does the code contain these
+ *    digits?" is a shift-and-mask compare per position (`ContainsDigits()`), no text needed.
+ */
+
+class PackCode
+{
+public:
+    static constexpr int kDigits = 16;
+
+    constexpr PackCode() = default;
+    constexpr explicit PackCode(uint64_t bits) : value(bits) {}
+
+    // Returns false (and leaves `out` alone) unless `text` holds exactly 16 hex digits
+    static bool Parse(std::string_view text, PackCode& out)
+    {
+        uint64_t bits = 0;
+        int digits = 0;
+        if (!ParseDigits(text, bits, digits) || digits != kDigits) return false;
+        out = PackCode(bits);
+        return true;
+    }
+
+    static bool IsValid(std::string_view text)
+    {
+        PackCode ignored;
+        return Parse(text, ignored);
+    }
+
+    // Reads up to 16 hex digits (dashes/spaces skipped) for a partial-code search. Returns
+    // false if `text` has anything else in it or is empty.
+    static bool ParseDigits(std::string_view text, uint64_t& outBits, int& outDigits)
+    {
+        outBits = 0;
+        outDigits = 0;
+        for (char c : text) {
+            if (c == '-' || c == ' ') continue;
+            const int nibble = HexValue(c);
+            if (nibble < 0 || outDigits == kDigits) return false;
+            outBits = (outBits << 4) | static_cast<uint64_t>(nibble);
+            ++outDigits;
+        }
+        return outDigits > 0;
+    }
+
+    uint64_t Value() const { return value; }
+
+    // "XXXX-XXXX-XXXX-XXXX", upper case
+    std::string ToString() const
+    {
+        static constexpr char kHex[] = "0123456789ABCDEF";
+        std::string text(kDigits + 3, '-');
+        for (int digit = 0, pos = 0; digit < kDigits; ++digit, ++pos) {
+            if (digit > 0 && digit % 4 == 0) ++pos;  // Skip over the dash
+            text[pos] = kHex[(value >> (4 * (kDigits - 1 - digit))) & 0xF];
+        }
+        return text;
+    }
+
+    // True if the code starts with the `digitCount` hex digits in `bits`
+    bool StartsWith(uint64_t bits, int digitCount) const
+    {
+        if (digitCount <= 0) return true;
+        return (value >> (4 * (kDigits - digitCount))) == bits;
+    }
+
+    // True if the `digitCount` hex digits in `bits` appear anywhere in the code
+    bool ContainsDigits(uint64_t bits, int digitCount) const
+    {
+        if (digitCount <= 0) return true;
+        const uint64_t mask = (digitCount == kDigits) ? ~uint64_t{0} : (uint64_t{1} << (4 * digitCount)) - 1;
+        for (int shift = 0; shift <= 4 * (kDigits - digitCount); shift += 4) {
+            if (((value >> shift) & mask) == bits) return true;
+        }
+        return false;
+    }
+
+    friend constexpr bool operator==(PackCode a, PackCode b) = default;
+    friend constexpr auto operator<=>(PackCode a, PackCode b) = default;
+
+private:
+    static int HexValue(char c)
+    {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    uint64_t value = 0;
+};
+
+template <>
+struct std::hash<PackCode>
+{
+    size_t operator()(PackCode code) const noexcept
+    {
+        // Codes are random-looking already; fold the high half in for 32-bit size_t
+        const uint64_t v = code.Value();
+        return static_cast<size_t>(v ^ (v >> 32));
+    }
+};
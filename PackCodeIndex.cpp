@@ -0,0 +1,71 @@
+#include "pch.h"
+#include "PackCodeIndex.h"
+
+template <typename Fn>
+void PackCodeIndex::ForEachRow(Fn&& fn)
+{
+    for (auto& entry : rowByCode) fn(entry.second);
+    for (auto& entry : rowByOddCode) fn(entry.second);
+}
+
+void PackCodeIndex::Clear()
+{
+    rowByCode.clear();
+    rowByOddCode.clear();
+}
+
+void PackCodeIndex::Build(const std::vector<TrainingEntry>& packs)
+{
+    Clear();
+    rowByCode.reserve(packs.size());
+    for (int row = 0; row < static_cast<int>(packs.size()); ++row) {
+        PackCode code;
+        if (PackCode::Parse(packs[row].code, code)) {
+            rowByCode.try_emplace(code, row);
+        } else {
+            rowByOddCode.try_emplace(packs[row].code, row);
+        }
+    }
+}
+
+void PackCodeIndex::InsertRow(int row, const std::string& code)
+{
+    ForEachRow([row](int& existing) { if (existing >= row) ++existing; });
+
+    PackCode parsed;
+    if (PackCode::Parse(code, parsed)) {
+        rowByCode.try_emplace(parsed, row);
+    } else {
+        rowByOddCode.try_emplace(code, row);
+    }
+}
+
+void PackCodeIndex::EraseRow(int row, const std::string& code)
+{
+    PackCode parsed;
+    if (PackCode::Parse(code, parsed)) {
+        auto it = rowByCode.find(parsed);
+        if (it != rowByCode.end() && it->second == row) rowByCode.erase(it);
+    } else {
+        auto it = rowByOddCode.find(code);
+        if (it != rowByOddCode.end() && it->second == row) rowByOddCode.erase(it);
+    }
+
+    ForEachRow([row](int& existing) { if (existing > row) --existing; });
+}
+
+int PackCodeIndex::Find(PackCode code) const
+{
+    auto it = rowByCode.find(code);
+    return it != rowByCode.end() ? it->second : kNotFound;
+}
+
+int PackCodeIndex::Find(const std::string& code) const
+{
+    PackCode parsed;
+    if (PackCode::Parse(code, parsed)) {
+        return Find(parsed);
+    }
+    auto it = rowByOddCode.find(code);
+    return it != rowByOddCode.end() ? it->second : kNotFound;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "MapList.h"
+#include "PackCode.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * ======================================================================================
+ * PACK CODE INDEX: FIND A PACK BY ITS CODE
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * A hash map from pack code ("A1B2-C3D4-...") to its row in the catalog.
+ *
+ * WHY IS IT HERE?
+ * Lots of places ask "which pack has this code?": the post-match loader, the quick picks
+ * list (every frame), the browser's popups, healing and every add/edit/delete. Walking
+ * 2000+ packs for each of those adds up; a hash lookup doesn't.
+ *
+ * HOW DOES IT WORK?
+ * Codes are keyed as `PackCode` numbers, so lookups hash and compare one integer and any
+ * spelling of a code ("ce79f64d...", "CE79-F64D-...") finds the same pack. The odd code
+ * that isn't 16 hex digits (hand-edited files) is kept in a small text-keyed side map.
+ * If the catalog somehow holds the same code twice, the first row wins (same as the old
+ * linear scans).
+ *
+ * Rows are positions in TrainingPackManager's sorted pack vector. `InsertRow()` /
+ * `EraseRow()` renumber the rows after the change, which walks the map once; edits are
+ * rare next to lookups, and the manager copies the pack vector for them anyway.
+ */
+
+class PackCodeIndex
+{
+public:
+    static constexpr int kNotFound = -1;
+
+    void Build(const std::vector<TrainingEntry>& packs);
+    void Clear();
+
+    // Keep the index aligned with the catalog after a single insert/erase
+    void InsertRow(int row, const std::string& code);
+    void EraseRow(int row, const std::string& code);
+
+    int Find(const std::string& code) const;
+    int Find(PackCode code) const;
+
+private:
+    template <typename Fn>
+    void ForEachRow(Fn&& fn);
+
+    std::unordered_map<PackCode, int> rowByCode;
+    std::unordered_map<std::string, int> rowByOddCode;  // Codes that don't parse
+};
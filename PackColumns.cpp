@@ -0,0 +1,230 @@
+#include "pch.h"
+#include "PackColumns.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+uint8_t PackColumns::DifficultyRank(std::string_view difficulty)
+{
+    std::string lower(difficulty);
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    if (lower == "bronze") return 1;
+    if (lower == "silver") return 2;
+    if (lower == "gold") return 3;
+    if (lower == "platinum") return 4;
+    if (lower == "diamond") return 5;
+    if (lower == "champion") return 6;
+    if (lower == "grand champion") return 7;
+    if (lower == "supersonic legend") return 8;
+    return 0;  // Empty, "Unknown", "All", "Unranked" and anything unrecognized
+}
+
+std::string PackColumns::FoldKey(std::string_view text)
+{
+    std::string key(text);
+    std::transform(key.begin(), key.end(), key.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return key;
+}
+
+void PackColumns::Clear()
+{
+    difficultyRank.clear();
+    shots.clear();
+    likes.clear();
+    plays.clear();
+    hasVideo.Reset(0);
+    for (auto& bits : difficultyBits) {
+        bits.Reset(0);
+    }
+    tagBits.clear();
+    tagOffsets.assign(1, 0);
+    tagIds.clear();
+    tagNames.clear();
+    tagLookup.clear();
+    nameKeys.clear();
+    creatorKeys.clear();
+    keyArena.clear();
+    liveKeyBytes = 0;
+}
+
+void PackColumns::Build(const std::vector<TrainingEntry>& packs)
+{
+    Clear();
+    const size_t count = packs.size();
+    difficultyRank.reserve(count);
+    shots.reserve(count);
+    likes.reserve(count);
+    plays.reserve(count);
+    hasVideo.Reset(count);
+    for (auto& bits : difficultyBits) {
+        bits.Reset(count);
+    }
+    tagOffsets.reserve(count + 1);
+    nameKeys.reserve(count);
+    creatorKeys.reserve(count);
+
+    for (size_t row = 0; row < count; ++row) {
+        const TrainingEntry& pack = packs[row];
+        difficultyRank.push_back(DifficultyRank(pack.difficulty));
+        difficultyBits[difficultyRank.back()].Set(static_cast<int>(row));
+        shots.push_back(pack.shotCount);
+        likes.push_back(pack.likes);
+        plays.push_back(pack.plays);
+        nameKeys.push_back(AppendKey(pack.name));
+        creatorKeys.push_back(AppendKey(pack.creator));
+        hasVideo.Set(static_cast<int>(row), !pack.videoUrl.empty());
+
+        for (const auto& tag : pack.tags) {
+            const uint16_t id = InternTag(tag, count);
+            tagIds.push_back(id);
+            tagBits[id].Set(static_cast<int>(row));
+        }
+        tagOffsets.push_back(static_cast<uint32_t>(tagIds.size()));
+    }
+}
+
+void PackColumns::InsertRow(int row, const TrainingEntry& pack)
+{
+    if (row < 0 || row > static_cast<int>(size())) return;
+
+    // New tags get a bitmap sized for the rows that exist before this insert
+    std::vector<uint16_t> ids;
+    ids.reserve(pack.tags.size());
+    for (const auto& tag : pack.tags) {
+        ids.push_back(InternTag(tag, size()));
+    }
+
+    const uint8_t rank = DifficultyRank(pack.difficulty);
+    hasVideo.InsertBit(row, !pack.videoUrl.empty());
+    for (int r = 0; r < kDifficultyRanks; ++r) {
+        difficultyBits[r].InsertBit(row, r == rank);
+    }
+    for (auto& bits : tagBits) {
+        bits.InsertBit(row, false);
+    }
+    for (uint16_t id : ids) {
+        tagBits[id].Set(row);
+    }
+
+    difficultyRank.insert(difficultyRank.begin() + row, rank);
+    shots.insert(shots.begin() + row, pack.shotCount);
+    likes.insert(likes.begin() + row, pack.likes);
+    plays.insert(plays.begin() + row, pack.plays);
+    nameKeys.insert(nameKeys.begin() + row, AppendKey(pack.name));
+    creatorKeys.insert(creatorKeys.begin() + row, AppendKey(pack.creator));
+
+    const uint32_t start = tagOffsets[row];
+    tagIds.insert(tagIds.begin() + start, ids.begin(), ids.end());
+    tagOffsets.insert(tagOffsets.begin() + row + 1, start);
+    for (size_t i = row + 1; i < tagOffsets.size(); ++i) {
+        tagOffsets[i] += static_cast<uint32_t>(ids.size());
+    }
+}
+
+void PackColumns::EraseRow(int row)
+{
+    if (row < 0 || row >= static_cast<int>(size())) return;
+
+    hasVideo.EraseBit(row);
+    for (auto& bits : difficultyBits) {
+        bits.EraseBit(row);
+    }
+    for (auto& bits : tagBits) {
+        bits.EraseBit(row);
+    }
+    difficultyRank.erase(difficultyRank.begin() + row);
+    shots.erase(shots.begin() + row);
+    likes.erase(likes.begin() + row);
+    plays.erase(plays.begin() + row);
+
+    liveKeyBytes -= nameKeys[row].length + creatorKeys[row].length;
+    nameKeys.erase(nameKeys.begin() + row);
+    creatorKeys.erase(creatorKeys.begin() + row);
+    if (keyArena.size() > 2 * liveKeyBytes + 4096) {
+        CompactKeys();
+    }
+
+    // Tag ids stay interned even if no pack uses them anymore; they just match nothing
+    const uint32_t start = tagOffsets[row];
+    const uint32_t removed = tagOffsets[row + 1] - start;
+    tagIds.erase(tagIds.begin() + start, tagIds.begin() + start + removed);
+    tagOffsets.erase(tagOffsets.begin() + row + 1);
+    for (size_t i = row + 1; i < tagOffsets.size(); ++i) {
+        tagOffsets[i] -= removed;
+    }
+}
+
+void PackColumns::SetShots(int row, int shotCount)
+{
+    if (row < 0 || row >= static_cast<int>(size())) return;
+    shots[row] = shotCount;
+}
+
+int PackColumns::FindTagId(const std::string& tag) const
+{
+    auto it = tagLookup.find(tag);
+    return it != tagLookup.end() ? it->second : kNoTag;
+}
+
+bool PackColumns::HasTag(int row, int tagId) const
+{
+    for (uint32_t i = tagOffsets[row]; i < tagOffsets[row + 1]; ++i) {
+        if (tagIds[i] == tagId) return true;
+    }
+    return false;
+}
+
+uint16_t PackColumns::InternTag(const std::string& tag, size_t rowCount)
+{
+    auto [it, inserted] = tagLookup.try_emplace(tag, static_cast<uint16_t>(tagNames.size()));
+    if (inserted) {
+        tagNames.push_back(tag);
+        tagBits.emplace_back(rowCount);
+    }
+    return it->second;
+}
+
+PackColumns::KeySpan PackColumns::AppendKey(std::string_view text)
+{
+    KeySpan key;
+    key.offset = static_cast<uint32_t>(keyArena.size());
+    key.length = static_cast<uint32_t>(text.size());
+    for (unsigned char c : text) {
+        keyArena.push_back(static_cast<char>(std::tolower(c)));
+    }
+    liveKeyBytes += key.length;
+    return key;
+}
+
+int PackColumns::CompareKeys(KeySpan a, KeySpan b) const
+{
+    const int cmp = std::memcmp(keyArena.data() + a.offset, keyArena.data() + b.offset,
+                                std::min(a.length, b.length));
+    if (cmp != 0) return cmp;
+    return (a.length < b.length) ? -1 : (a.length > b.length) ? 1 : 0;
+}
+
+int PackColumns::NameUpperBound(std::string_view foldedName) const
+{
+    auto it = std::upper_bound(nameKeys.begin(), nameKeys.end(), foldedName,
+        [this](std::string_view name, KeySpan key) { return name < KeyText(key); });
+    return static_cast<int>(it - nameKeys.begin());
+}
+
+void PackColumns::CompactKeys()
+{
+    std::string packed;
+    packed.reserve(liveKeyBytes);
+    auto repack = [this, &packed](KeySpan& key) {
+        const uint32_t offset = static_cast<uint32_t>(packed.size());
+        packed.append(keyArena, key.offset, key.length);
+        key.offset = offset;
+    };
+    for (auto& key : nameKeys) repack(key);
+    for (auto& key : creatorKeys) repack(key);
+    keyArena.swap(packed);
+}
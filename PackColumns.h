@@ -0,0 +1,107 @@
+#pragma once
+#include "MapList.h"
+#include "PackBitmap.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * ======================================================================================
+ * PACK COLUMNS: THE FILTER-FRIENDLY COPY
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * The few pack fields the browser filters and sorts on (difficulty, shots, likes, plays,
+ * video, tags), stored as one tightly packed array per field instead of one big struct
+ * per pack.
+ *
+ * WHY IS IT HERE?
+ * A `TrainingEntry` carries notes, staff comments and URLs around with it. Checking
+ * "Diamond, 10+ shots, has video" against 2000+ of those pulls all of that text through
+ * the CPU cache for nothing. These arrays hold just the numbers, so a filter pass
+ * touches a few kilobytes instead of megabytes.
+ *
+ * HOW DOES IT WORK?
+ * 1. `difficultyRank`: 0 = Unranked, 1 = Bronze ... 8 = Supersonic Legend.
+ * 2. `shots` / `likes` / `plays`: plain int32 copies of the entry fields.
+ * 3. Facet bitmaps (`PackBitmap`): `hasVideo`, one per difficulty rank in
+ *    `difficultyBits` (rank 0 covers empty/"Unknown"/"All"/"Unranked"), and one per tag
+ *    id in `tagBits`. Filters combine these with word-wide AND/OR.
+ * 4. Tags: every distinct tag string gets a small id. Row `r` owns the ids in
+ *    `tagIds[tagOffsets[r] .. tagOffsets[r + 1])`.
+ * 5. Name/creator sort keys: lowercased once and packed into one shared character
+ *    buffer, so case-insensitive sorting is a plain `memcmp` with no allocations.
+ *
+ * Rows line up with TrainingPackManager's sorted pack vector, exactly like
+ * `PackSearchIndex`; the manager calls `InsertRow()` / `EraseRow()` alongside it.
+ */
+
+class PackColumns
+{
+public:
+    static constexpr int kNoTag = -1;
+    static constexpr int kDifficultyRanks = 9;  // Unranked + Bronze..Supersonic Legend
+
+    void Build(const std::vector<TrainingEntry>& packs);
+    void Clear();
+
+    // Keep the columns aligned with the catalog after a single insert/erase/edit
+    void InsertRow(int row, const TrainingEntry& pack);
+    void EraseRow(int row);
+    void SetShots(int row, int shotCount);
+
+    // Maps a difficulty string (any case) to its rank; unrecognized values are Unranked
+    static uint8_t DifficultyRank(std::string_view difficulty);
+
+    // Lowercased sort key; comparing two keys bytewise is the case-insensitive order
+    static std::string FoldKey(std::string_view text);
+
+    // Three-way case-insensitive comparisons between rows (<0, 0, >0)
+    int CompareName(int rowA, int rowB) const { return CompareKeys(nameKeys[rowA], nameKeys[rowB]); }
+    int CompareCreator(int rowA, int rowB) const { return CompareKeys(creatorKeys[rowA], creatorKeys[rowB]); }
+
+    // First row whose name sorts after `foldedName` (rows are kept in name order)
+    int NameUpperBound(std::string_view foldedName) const;
+
+    // Tag id for an exact tag string, or kNoTag if no pack has ever used it
+    int FindTagId(const std::string& tag) const;
+
+    size_t size() const { return difficultyRank.size(); }
+    bool HasVideo(int row) const { return hasVideo.Test(row); }
+    bool HasTag(int row, int tagId) const;
+
+    std::vector<uint8_t> difficultyRank;
+    std::vector<int32_t> shots;
+    std::vector<int32_t> likes;
+    std::vector<int32_t> plays;
+    PackBitmap hasVideo;
+    PackBitmap difficultyBits[kDifficultyRanks];  // Indexed by difficulty rank
+    std::vector<PackBitmap> tagBits;              // Indexed by tag id
+    std::vector<uint32_t> tagOffsets{ 0 };  // size() + 1 entries
+    std::vector<uint16_t> tagIds;
+    std::vector<std::string> tagNames;  // Indexed by tag id
+
+private:
+    // A key is a slice of keyArena. Erased rows leave dead bytes behind until the
+    // arena is repacked.
+    struct KeySpan
+    {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    uint16_t InternTag(const std::string& tag, size_t rowCount);
+    KeySpan AppendKey(std::string_view text);
+    std::string_view KeyText(KeySpan key) const { return std::string_view(keyArena.data() + key.offset, key.length); }
+    int CompareKeys(KeySpan a, KeySpan b) const;
+    void CompactKeys();
+
+    std::vector<KeySpan> nameKeys;
+    std::vector<KeySpan> creatorKeys;
+    std::string keyArena;
+    size_t liveKeyBytes = 0;
+
+    std::unordered_map<std::string, uint16_t> tagLookup;
+};
@@ -0,0 +1,75 @@
+#include "pch.h"
+#include "PackDelta.h"
+#include "PackCodeIndex.h"
+
+namespace
+{
+    // Each patched row shifts the rows after it in every index; past 1 change in 8 it's
+    // cheaper to build the indexes once
+    constexpr size_t kRebuildDivisor = 8;
+
+    bool SamePack(const TrainingEntry& a, const TrainingEntry& b)
+    {
+        return a.code == b.code && a.name == b.name && a.creator == b.creator &&
+               a.creatorSlug == b.creatorSlug && a.difficulty == b.difficulty && a.tags == b.tags &&
+               a.shotCount == b.shotCount && a.staffComments == b.staffComments && a.notes == b.notes &&
+               a.videoUrl == b.videoUrl && a.likes == b.likes && a.plays == b.plays &&
+               a.status == b.status && a.source == b.source && a.isModified == b.isModified;
+    }
+
+    // Packs the scraper must never touch
+    bool IsUserOwned(const TrainingEntry& pack)
+    {
+        return pack.source == "custom" || pack.isModified;
+    }
+}
+
+bool PackDelta::IsLarge(size_t catalogSize) const
+{
+    return size() * kRebuildDivisor > catalogSize;
+}
+
+PackDelta PackDelta::Compute(const PackCatalog& current, const std::vector<TrainingEntry>& scraped)
+{
+    PackDelta delta;
+
+    PackCodeIndex scrapedIndex;
+    scrapedIndex.Build(scraped);
+
+    for (int row = 0; row < static_cast<int>(scraped.size()); ++row) {
+        const TrainingEntry& pack = scraped[row];
+        if (scrapedIndex.Find(pack.code) != row) continue;  // Duplicate code; the first one wins
+
+        const int currentRow = current.codeIndex.Find(pack.code);
+        if (currentRow == PackCodeIndex::kNotFound) {
+            delta.added.push_back(pack);
+        } else {
+            const TrainingEntry& existing = current.packs[currentRow];
+            if (!IsUserOwned(existing) && !SamePack(existing, pack)) {
+                delta.changed.push_back(pack);
+            }
+        }
+    }
+
+    for (const auto& existing : current.packs) {
+        if (!IsUserOwned(existing) && scrapedIndex.Find(existing.code) == PackCodeIndex::kNotFound) {
+            delta.removed.push_back(existing.code);
+        }
+    }
+    return delta;
+}
+
+void PackDelta::ApplyTo(PackCatalog& catalog) const
+{
+    for (const auto& code : removed) {
+        const int row = catalog.codeIndex.Find(code);
+        if (row != PackCodeIndex::kNotFound) catalog.Erase(row);
+    }
+    for (const auto& pack : changed) {
+        const int row = catalog.codeIndex.Find(pack.code);
+        if (row != PackCodeIndex::kNotFound) catalog.Replace(row, pack);
+    }
+    for (const auto& pack : added) {
+        catalog.Insert(pack);
+    }
+}
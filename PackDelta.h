@@ -0,0 +1,47 @@
+#pragma once
+#include "MapList.h"
+#include "PackCatalog.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * ======================================================================================
+ * PACK DELTA: WHAT A SCRAPE ACTUALLY CHANGED
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * The difference between the catalog you have and a freshly scraped one, matched by code:
+ * which packs are new, which are gone, and which came back with different details.
+ *
+ * WHY IS IT HERE?
+ * After "Update Pack List" the whole catalog used to be thrown away and loaded again, even
+ * when only a handful of packs had changed upstream. Now only those packs are patched into
+ * the catalog, and the browser can say what the update brought in.
+ *
+ * HOW DOES IT WORK?
+ * 1. The manager reads the new scrape and replays the user's overlay on top of it, so the
+ *    scrape looks exactly like the catalog a full reload would give.
+ * 2. `Compute()` walks the scrape once against the current catalog's code index.
+ *    Custom packs and packs the user edited (`isModified`) are never removed or overwritten.
+ * 3. `ApplyTo()` patches just those rows into a copy of the catalog, indexes included. A
+ *    delta touching a large share of the catalog (e.g. the very first scrape) is cheaper to
+ *    rebuild from scratch, which `IsLarge()` tells the manager.
+ */
+
+struct PackDelta
+{
+    std::vector<TrainingEntry> added;    // In the scrape, not in the catalog
+    std::vector<TrainingEntry> changed;  // New details for packs already in the catalog
+    std::vector<std::string> removed;    // Codes the scrape no longer has
+    uint64_t version = 0;                // Catalog version the delta produced (0 if none)
+
+    bool empty() const { return added.empty() && changed.empty() && removed.empty(); }
+    size_t size() const { return added.size() + changed.size() + removed.size(); }
+
+    // True when patching row by row would cost more than rebuilding every index
+    bool IsLarge(size_t catalogSize) const;
+
+    static PackDelta Compute(const PackCatalog& current, const std::vector<TrainingEntry>& scraped);
+    void ApplyTo(PackCatalog& catalog) const;
+};
@@ -0,0 +1,348 @@
+#include "pch.h"
+#include "PackJsonReader.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string_view>
+
+namespace
+{
+    enum class PackField
+    {
+        None,
+        Code,
+        Name,
+        Creator,
+        CreatorSlug,
+        Difficulty,
+        ShotCount,
+        StaffComments,
+        Notes,
+        VideoUrl,
+        Likes,
+        Plays,
+        Status,
+        Tags,
+        Source,
+        IsModified
+    };
+
+    PackField FieldFromKey(std::string_view key)
+    {
+        if (key == "code") return PackField::Code;
+        if (key == "name") return PackField::Name;
+        if (key == "creator") return PackField::Creator;
+        if (key == "creatorSlug") return PackField::CreatorSlug;
+        if (key == "difficulty") return PackField::Difficulty;
+        if (key == "shotCount") return PackField::ShotCount;
+        if (key == "staffComments") return PackField::StaffComments;
+        if (key == "notes") return PackField::Notes;
+        if (key == "videoUrl") return PackField::VideoUrl;
+        if (key == "likes") return PackField::Likes;
+        if (key == "plays") return PackField::Plays;
+        if (key == "status") return PackField::Status;
+        if (key == "tags") return PackField::Tags;
+        if (key == "source") return PackField::Source;
+        if (key == "isModified") return PackField::IsModified;
+        return PackField::None;  // Includes the retired bagCategories/orderInBag fields
+    }
+
+    // Nesting depths while reading { "packs": [ { ..., "tags": [ ... ] } ] }
+    constexpr int kRootDepth = 1;
+    constexpr int kPackDepth = 3;
+    constexpr int kTagsDepth = 4;
+
+    // Packs between progress reports; asking the stream for its position isn't free
+    constexpr size_t kProgressInterval = 256;
+
+    class PackSaxHandler : public nlohmann::json_sax<nlohmann::json>
+    {
+    public:
+        PackSaxHandler(std::vector<TrainingEntry>& out, std::istream& in,
+                       std::streamoff streamSize, const std::function<void(float)>& onProgress)
+            : packs(out), stream(in), size(streamSize), progress(onProgress) {}
+
+        bool FoundPacksArray() const { return foundPacks; }
+        const std::string& Error() const { return error; }
+
+        bool null() override
+        {
+            field = PackField::None;
+            return true;
+        }
+
+        bool boolean(bool value) override
+        {
+            if (AtPackField() && field == PackField::IsModified) {
+                entry.isModified = value;
+            }
+            field = PackField::None;
+            return true;
+        }
+
+        bool number_integer(number_integer_t value) override { return Number(static_cast<int>(value)); }
+        bool number_unsigned(number_unsigned_t value) override { return Number(static_cast<int>(value)); }
+        bool number_float(number_float_t value, const string_t&) override { return Number(static_cast<int>(value)); }
+
+        bool string(string_t& value) override
+        {
+            if (inTags && depth == kTagsDepth) {
+                entry.tags.push_back(std::move(value));
+                return true;
+            }
+            if (!AtPackField()) return true;
+
+            switch (field) {
+                case PackField::Code:          entry.code = std::move(value); break;
+                case PackField::Name:          entry.name = std::move(value); break;
+                case PackField::Creator:       entry.creator = std::move(value); break;
+                case PackField::CreatorSlug:   entry.creatorSlug = std::move(value); break;
+                case PackField::Difficulty:    entry.difficulty = std::move(value); break;
+                case PackField::StaffComments: entry.staffComments = std::move(value); break;
+                case PackField::Notes:         entry.notes = std::move(value); break;
+                case PackField::VideoUrl:      entry.videoUrl = std::move(value); break;
+                case PackField::Source:        entry.source = std::move(value); break;
+                default: break;
+            }
+            field = PackField::None;
+            return true;
+        }
+
+        bool binary(binary_t&) override
+        {
+            field = PackField::None;
+            return true;
+        }
+
+        bool start_object(std::size_t) override
+        {
+            if (inPacksArray && depth == kPackDepth - 1) {
+                entry = TrainingEntry();
+                inPack = true;
+            }
+            ++depth;
+            return true;
+        }
+
+        bool end_object() override
+        {
+            --depth;
+            if (inPack && depth == kPackDepth - 1) {
+                if (!entry.code.empty() && !entry.name.empty()) {
+                    packs.push_back(std::move(entry));
+                }
+                inPack = false;
+                if (progress && ++packsSinceReport >= kProgressInterval) {
+                    ReportProgress();
+                }
+            }
+            field = PackField::None;
+            return true;
+        }
+
+        bool start_array(std::size_t) override
+        {
+            if (depth == kRootDepth && rootKeyIsPacks) {
+                inPacksArray = true;
+                foundPacks = true;
+            } else if (AtPackField() && field == PackField::Tags) {
+                entry.tags.clear();  // A repeated "tags" key replaces the earlier list
+                inTags = true;
+            }
+            ++depth;
+            return true;
+        }
+
+        bool end_array() override
+        {
+            --depth;
+            if (inTags && depth == kPackDepth) {
+                inTags = false;
+            } else if (inPacksArray && depth == kRootDepth) {
+                inPacksArray = false;
+            }
+            field = PackField::None;
+            return true;
+        }
+
+        bool key(string_t& name) override
+        {
+            if (depth == kRootDepth) {
+                rootKeyIsPacks = (name == "packs");
+            } else if (inPack && depth == kPackDepth) {
+                field = FieldFromKey(name);
+            }
+            return true;
+        }
+
+        bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& ex) override
+        {
+            error = "at byte " + std::to_string(position) + ": " + ex.what();
+            return false;
+        }
+
+    private:
+        bool AtPackField() const { return inPack && depth == kPackDepth && !inTags; }
+
+        void ReportProgress()
+        {
+            packsSinceReport = 0;
+            const std::streamoff position = stream.tellg();
+            if (position >= 0 && size > 0) {
+                progress(std::min(1.0f, static_cast<float>(position) / static_cast<float>(size)));
+            }
+        }
+
+        bool Number(int value)
+        {
+            if (AtPackField()) {
+                switch (field) {
+                    case PackField::ShotCount: entry.shotCount = value; break;
+                    case PackField::Likes:     entry.likes = value; break;
+                    case PackField::Plays:     entry.plays = value; break;
+                    case PackField::Status:    entry.status = value; break;
+                    default: break;
+                }
+            }
+            field = PackField::None;
+            return true;
+        }
+
+        std::vector<TrainingEntry>& packs;
+        std::istream& stream;
+        std::streamoff size;
+        const std::function<void(float)>& progress;
+        size_t packsSinceReport = 0;
+        TrainingEntry entry;
+        PackField field = PackField::None;
+        int depth = 0;
+        bool rootKeyIsPacks = false;
+        bool inPacksArray = false;
+        bool inPack = false;
+        bool inTags = false;
+        bool foundPacks = false;
+        std::string error;
+    };
+}
+
+bool PackJsonReader::Read(std::istream& in, std::vector<TrainingEntry>& out,
+                          const std::function<void(float)>& onProgress)
+{
+    // Progress is position / end of stream, so find the end once up front
+    std::streamoff size = 0;
+    if (onProgress) {
+        const auto start = in.tellg();
+        in.seekg(0, std::ios::end);
+        size = in.tellg();
+        in.seekg(start);
+    }
+
+    PackSaxHandler handler(out, in, size, onProgress);
+    const bool parsed = nlohmann::json::sax_parse(in, &handler);
+
+    if (!parsed) {
+        LOG("SuiteSpot: Pack cache is not valid JSON ({})", handler.Error());
+        return false;
+    }
+    if (!handler.FoundPacksArray()) {
+        LOG("SuiteSpot: Invalid Pack cache file format - missing 'packs' array");
+        return false;
+    }
+    return true;
+}
+
+nlohmann::json PackJsonReader::ToJson(const TrainingEntry& pack)
+{
+    nlohmann::json p;
+    p["name"] = pack.name;
+    p["code"] = pack.code;
+    p["creator"] = pack.creator;
+    p["creatorSlug"] = pack.creatorSlug;
+    p["difficulty"] = pack.difficulty;
+    p["shotCount"] = pack.shotCount;
+    p["tags"] = pack.tags;
+    p["videoUrl"] = pack.videoUrl;
+    p["staffComments"] = pack.staffComments;
+    p["notes"] = pack.notes;
+    p["likes"] = pack.likes;
+    p["plays"] = pack.plays;
+    p["status"] = pack.status;
+    p["source"] = pack.source;
+    p["isModified"] = pack.isModified;
+    return p;
+}
+
+TrainingEntry PackJsonReader::FromJson(const nlohmann::json& p)
+{
+    TrainingEntry pack;
+    auto readString = [&p](const char* key, std::string& out) {
+        auto it = p.find(key);
+        if (it != p.end() && it->is_string()) out = it->get<std::string>();
+    };
+    auto readInt = [&p](const char* key, int& out) {
+        auto it = p.find(key);
+        if (it != p.end() && it->is_number()) out = it->get<int>();
+    };
+
+    readString("name", pack.name);
+    readString("code", pack.code);
+    readString("creator", pack.creator);
+    readString("creatorSlug", pack.creatorSlug);
+    readString("difficulty", pack.difficulty);
+    readString("videoUrl", pack.videoUrl);
+    readString("staffComments", pack.staffComments);
+    readString("notes", pack.notes);
+    readString("source", pack.source);
+    readInt("shotCount", pack.shotCount);
+    readInt("likes", pack.likes);
+    readInt("plays", pack.plays);
+    readInt("status", pack.status);
+
+    if (auto it = p.find("tags"); it != p.end() && it->is_array()) {
+        for (const auto& tag : *it) {
+            if (tag.is_string()) pack.tags.push_back(tag.get<std::string>());
+        }
+    }
+    if (auto it = p.find("isModified"); it != p.end() && it->is_boolean()) {
+        pack.isModified = it->get<bool>();
+    }
+    return pack;
+}
+
+bool PackJsonReader::WriteFile(const std::filesystem::path& path, const std::vector<TrainingEntry>& packs,
+                               const std::string& sourceUrl)
+{
+    try {
+        nlohmann::json root;
+        root["version"] = "1.1.0";
+        root["source"] = sourceUrl;
+        root["totalPacks"] = packs.size();
+        root["packs"] = nlohmann::json::array();
+        for (const auto& pack : packs) {
+            root["packs"].push_back(ToJson(pack));
+        }
+
+        // Write next to the old file and swap, so a crash never leaves half a catalog behind
+        std::filesystem::create_directories(path.parent_path());
+        auto tempPath = path;
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                LOG("SuiteSpot: Failed to write pack file: {}", tempPath.string());
+                return false;
+            }
+            file << root.dump(2);
+            if (!file) {
+                LOG("SuiteSpot: Failed to write pack file: {}", tempPath.string());
+                return false;
+            }
+        }
+        std::filesystem::rename(tempPath, path);
+        return true;
+
+    } catch (const std::exception& e) {
+        LOG("SuiteSpot: Error writing pack file: {}", std::string(e.what()));
+        return false;
+    }
+}
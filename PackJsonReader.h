@@ -0,0 +1,52 @@
+#pragma once
+#include "MapList.h"
+#include "IMGUI/json.hpp"
+#include <filesystem>
+#include <functional>
+#include <istream>
+#include <string>
+#include <vector>
+
+/*
+ * ======================================================================================
+ * PACK JSON READER: STREAMING LOADER FOR training_packs.json
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * Reads `training_packs.json` straight into `TrainingEntry` objects.
+ *
+ * WHY IS IT HERE?
+ * Loading the whole file into a JSON tree first means holding every pack twice (once
+ * as JSON, once as packs) and walking the tree again afterwards. Reading it as a stream
+ * of events ("key", "string", "start array"...) fills each pack as its fields go by.
+ *
+ * HOW DOES IT WORK?
+ * It uses nlohmann's SAX interface. A small state machine tracks nesting depth so it
+ * knows when it's inside the top-level `packs` array, inside one pack object, or inside
+ * that pack's `tags` array. Everything else is skipped.
+ *
+ * Same rules as the old tree-based loader: fields with the wrong type are ignored,
+ * `source` defaults to "prejump", and packs without a code or name are dropped.
+ *
+ * An optional progress callback gets the fraction of the stream read so far, every few
+ * hundred packs, so a background load can report how far along it is.
+ *
+ * `ToJson()` / `FromJson()` convert a single pack (the overlay's lines and the scraper's
+ * pages use them), and `WriteFile()` writes a whole catalog file in the same layout.
+ */
+
+namespace PackJsonReader
+{
+    // Appends every valid pack to `out`. Returns false (and logs why) if the JSON is
+    // malformed or has no top-level `packs` array. `onProgress` receives 0..1.
+    bool Read(std::istream& in, std::vector<TrainingEntry>& out,
+              const std::function<void(float)>& onProgress = nullptr);
+
+    // One pack object, same field rules as Read()
+    nlohmann::json ToJson(const TrainingEntry& pack);
+    TrainingEntry FromJson(const nlohmann::json& object);
+
+    // Writes a complete training_packs.json (via a temp file). Returns false and logs on failure.
+    bool WriteFile(const std::filesystem::path& path, const std::vector<TrainingEntry>& packs,
+                   const std::string& sourceUrl);
+}
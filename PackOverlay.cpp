@@ -0,0 +1,409 @@
+#include "pch.h"
+#include "PackOverlay.h"
+#include "PackJsonReader.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+    // Below this many lines the overlay is never worth compacting
+    constexpr size_t kCompactMinLines = 256;
+
+    // Appends and compactions take turns. `writeGeneration` goes up with each one, so a
+    // compaction can tell whether the file changed after it was read (it then skips, rather
+    // than replacing the file and losing the new lines).
+    std::mutex fileMutex;
+    uint64_t writeGeneration = 0;  // fileMutex
+
+    std::string OpToLine(const PackOverlay::Op& op)
+    {
+        nlohmann::json line;
+        switch (op.kind) {
+            case PackOverlay::Op::Kind::Upsert:
+                line["op"] = "upsert";
+                line["pack"] = PackJsonReader::ToJson(op.pack);
+                break;
+            case PackOverlay::Op::Kind::Delete:
+                line["op"] = "delete";
+                line["code"] = op.code;
+                break;
+            case PackOverlay::Op::Kind::Heal:
+                line["op"] = "heal";
+                line["code"] = op.code;
+                line["shots"] = op.shots;
+                if (!op.creator.empty()) line["creator"] = op.creator;
+                if (!op.notes.empty()) line["notes"] = op.notes;
+                break;
+        }
+        return line.dump();  // Single line, no indentation
+    }
+
+    bool OpFromLine(const std::string& text, PackOverlay::Op& op)
+    {
+        const auto line = nlohmann::json::parse(text, nullptr, false);
+        if (line.is_discarded() || !line.is_object()) return false;
+
+        const auto kind = line.find("op");
+        if (kind == line.end() || !kind->is_string()) return false;
+
+        const auto codeIt = line.find("code");
+        const bool hasCode = codeIt != line.end() && codeIt->is_string();
+
+        if (*kind == "upsert") {
+            const auto pack = line.find("pack");
+            if (pack == line.end() || !pack->is_object()) return false;
+            op = PackOverlay::Op::Upsert(PackJsonReader::FromJson(*pack));
+            return !op.pack.code.empty() && !op.pack.name.empty();
+        }
+        if (*kind == "delete" && hasCode) {
+            op = PackOverlay::Op::Delete(codeIt->get<std::string>());
+            return true;
+        }
+        if (*kind == "heal" && hasCode) {
+            const auto shots = line.find("shots");
+            if (shots == line.end() || !shots->is_number()) return false;
+            const auto text = [&line](const char* key) {
+                const auto it = line.find(key);
+                return it != line.end() && it->is_string() ? it->get<std::string>() : std::string();
+            };
+            op = PackOverlay::Op::Heal(codeIt->get<std::string>(), shots->get<int>(), text("creator"), text("notes"));
+            return true;
+        }
+        return false;
+    }
+
+    // The overlay reduced to one op per touched pack, in first-touched order
+    class NetChanges
+    {
+    public:
+        void Record(const PackOverlay::Op& op)
+        {
+            auto [it, inserted] = slotByCode.try_emplace(op.Code(), net.size());
+            if (inserted) {
+                net.push_back(op);
+            } else {
+                PackOverlay::Merge(net[it->second], op);
+            }
+        }
+
+        size_t size() const { return net.size(); }
+
+        // A delete or heal of a code the base doesn't have (and the overlay no longer adds)
+        // does nothing, so it needs no line at all
+        std::vector<PackOverlay::Op> Ops(const std::unordered_map<std::string, size_t>& baseRows) const
+        {
+            std::vector<PackOverlay::Op> ops;
+            ops.reserve(net.size());
+            for (const auto& op : net) {
+                if (op.kind != PackOverlay::Op::Kind::Upsert && baseRows.find(op.code) == baseRows.end()) {
+                    continue;
+                }
+                ops.push_back(op);
+            }
+            return ops;
+        }
+
+    private:
+        std::vector<PackOverlay::Op> net;
+        std::unordered_map<std::string, size_t> slotByCode;
+    };
+
+    bool WriteOps(std::ofstream& file, const std::vector<PackOverlay::Op>& ops)
+    {
+        for (const auto& op : ops) {
+            file << OpToLine(op) << '\n';
+        }
+        file.flush();
+        return static_cast<bool>(file);
+    }
+
+    // `readGeneration` is writeGeneration from before the file was read
+    void Compact(const std::filesystem::path& overlayPath, const std::vector<PackOverlay::Op>& ops, size_t oldLines,
+                 uint64_t readGeneration)
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        if (writeGeneration != readGeneration) {
+            LOG("SuiteSpot: Pack overlay changed while it was read; compacting next time");
+            return;
+        }
+        try {
+            auto tempPath = overlayPath;
+            tempPath += ".tmp";
+            {
+                std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+                if (!file.is_open() || !WriteOps(file, ops)) {
+                    LOG("SuiteSpot: Failed to write compacted pack overlay: {}", tempPath.string());
+                    return;
+                }
+            }
+            std::filesystem::rename(tempPath, overlayPath);
+            ++writeGeneration;
+            LOG("SuiteSpot: Compacted pack overlay ({} -> {} lines)", oldLines, ops.size());
+        } catch (const std::exception& e) {
+            LOG("SuiteSpot: Error compacting pack overlay: {}", std::string(e.what()));
+        }
+    }
+}
+
+PackOverlay::Op PackOverlay::Op::Upsert(const TrainingEntry& pack)
+{
+    Op op;
+    op.kind = Kind::Upsert;
+    op.pack = pack;
+    return op;
+}
+
+PackOverlay::Op PackOverlay::Op::Delete(const std::string& code)
+{
+    Op op;
+    op.kind = Kind::Delete;
+    op.code = code;
+    return op;
+}
+
+PackOverlay::Op PackOverlay::Op::Heal(const std::string& code, int shots, const std::string& creator,
+                                      const std::string& notes)
+{
+    Op op;
+    op.kind = Kind::Heal;
+    op.code = code;
+    op.shots = shots;
+    op.creator = creator;
+    op.notes = notes;
+    return op;
+}
+
+bool PackOverlay::ApplyHeal(const Op& heal, TrainingEntry& pack)
+{
+    bool changed = false;
+    if (pack.shotCount != heal.shots) {
+        pack.shotCount = heal.shots;
+        changed = true;
+    }
+    // Scraped or user-edited text always wins over what the training editor reports
+    if (pack.creator.empty() && !heal.creator.empty()) {
+        pack.creator = heal.creator;
+        changed = true;
+    }
+    if (pack.staffComments.empty() && pack.notes.empty() && !heal.notes.empty()) {
+        pack.notes = heal.notes;
+        changed = true;
+    }
+    return changed;
+}
+
+void PackOverlay::Merge(Op& earlier, const Op& later)
+{
+    if (later.kind != Op::Kind::Heal) {
+        earlier = later;
+    } else if (earlier.kind == Op::Kind::Upsert) {
+        ApplyHeal(later, earlier.pack);  // Fold the heal into the stored pack
+    } else if (earlier.kind == Op::Kind::Heal) {
+        // Both only fill blanks, so the first text offered is the one that would stick
+        earlier.shots = later.shots;
+        if (earlier.creator.empty()) earlier.creator = later.creator;
+        if (earlier.notes.empty()) earlier.notes = later.notes;
+    }
+    // A heal after a delete changes nothing
+}
+
+std::filesystem::path PackOverlay::PathFor(const std::filesystem::path& jsonPath)
+{
+    std::filesystem::path overlayPath = jsonPath;
+    overlayPath.replace_extension(".overlay.jsonl");
+    return overlayPath;
+}
+
+bool PackOverlay::Append(const std::filesystem::path& jsonPath, const std::vector<Op>& ops)
+{
+    if (jsonPath.empty() || ops.empty()) return false;
+
+    std::lock_guard<std::mutex> lock(fileMutex);
+    ++writeGeneration;
+    try {
+        const auto overlayPath = PathFor(jsonPath);
+        std::filesystem::create_directories(overlayPath.parent_path());
+
+        // A write cut off mid-line (crash, full disk) would swallow the next line too; end it first
+        bool needsNewline = false;
+        {
+            std::ifstream existing(overlayPath, std::ios::binary | std::ios::ate);
+            if (existing.is_open() && existing.tellg() > 0) {
+                existing.seekg(-1, std::ios::end);
+                needsNewline = existing.get() != '\n';
+            }
+        }
+
+        std::ofstream file(overlayPath, std::ios::binary | std::ios::app);
+        if (file.is_open() && needsNewline) {
+            file << '\n';
+        }
+        if (!file.is_open() || !WriteOps(file, ops)) {
+            LOG("SuiteSpot: Failed to append to pack overlay: {}", overlayPath.string());
+            return false;
+        }
+        return true;
+
+    } catch (const std::exception& e) {
+        LOG("SuiteSpot: Error writing pack overlay: {}", std::string(e.what()));
+        return false;
+    }
+}
+
+bool PackOverlay::Prepend(const std::filesystem::path& jsonPath, const std::vector<Op>& ops)
+{
+    if (jsonPath.empty() || ops.empty()) return false;
+
+    std::lock_guard<std::mutex> lock(fileMutex);
+    ++writeGeneration;
+    try {
+        const auto overlayPath = PathFor(jsonPath);
+        std::filesystem::create_directories(overlayPath.parent_path());
+
+        std::string existing;
+        {
+            std::ifstream file(overlayPath, std::ios::binary);
+            if (file.is_open()) {
+                existing.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            }
+        }
+
+        // New lines first, then the old file as it was; swapped in so a crash loses neither
+        auto tempPath = overlayPath;
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open() || !WriteOps(file, ops)) {
+                LOG("SuiteSpot: Failed to write pack overlay: {}", tempPath.string());
+                return false;
+            }
+            file << existing;
+            file.flush();
+            if (!file) {
+                LOG("SuiteSpot: Failed to write pack overlay: {}", tempPath.string());
+                return false;
+            }
+        }
+        std::filesystem::rename(tempPath, overlayPath);
+        return true;
+
+    } catch (const std::exception& e) {
+        LOG("SuiteSpot: Error writing pack overlay: {}", std::string(e.what()));
+        return false;
+    }
+}
+
+PackOverlay::ApplyResult PackOverlay::ApplyOps(std::vector<Op> ops, std::vector<TrainingEntry>& packs)
+{
+    ApplyResult result;
+    std::unordered_map<std::string, size_t> rowByCode;
+    rowByCode.reserve(packs.size());
+    for (size_t i = 0; i < packs.size(); ++i) {
+        rowByCode.emplace(packs[i].code, i);
+    }
+    std::vector<bool> deleted(packs.size(), false);
+
+    for (auto& op : ops) {
+        if (op.kind == Op::Kind::Upsert) {
+            auto [it, inserted] = rowByCode.try_emplace(op.pack.code, packs.size());
+            if (inserted) {
+                packs.push_back(std::move(op.pack));
+                deleted.push_back(false);
+                result.needsSort = true;
+            } else {
+                TrainingEntry& row = packs[it->second];
+                if (row.name != op.pack.name) result.needsSort = true;
+                row = std::move(op.pack);
+                deleted[it->second] = false;
+            }
+            ++result.applied;
+            continue;
+        }
+
+        auto it = rowByCode.find(op.code);
+        if (it == rowByCode.end() || deleted[it->second]) continue;
+
+        if (op.kind == Op::Kind::Delete) {
+            deleted[it->second] = true;
+        } else {
+            ApplyHeal(op, packs[it->second]);
+        }
+        ++result.applied;
+    }
+
+    if (std::find(deleted.begin(), deleted.end(), true) != deleted.end()) {
+        size_t keep = 0;
+        for (size_t i = 0; i < packs.size(); ++i) {
+            if (!deleted[i]) {
+                if (keep != i) packs[keep] = std::move(packs[i]);
+                ++keep;
+            }
+        }
+        packs.resize(keep);
+    }
+    return result;
+}
+
+PackOverlay::ApplyResult PackOverlay::Apply(const std::filesystem::path& jsonPath, std::vector<TrainingEntry>& packs)
+{
+    ApplyResult result;
+    const auto overlayPath = PathFor(jsonPath);
+
+    uint64_t readGeneration = 0;
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        readGeneration = writeGeneration;
+    }
+
+    std::error_code ec;
+    if (!std::filesystem::exists(overlayPath, ec)) return result;
+
+    std::ifstream file(overlayPath, std::ios::binary);
+    if (!file.is_open()) {
+        LOG("SuiteSpot: Failed to open pack overlay: {}", overlayPath.string());
+        return result;
+    }
+
+    // Rows of the base catalog; compaction needs to know which codes came from it
+    std::unordered_map<std::string, size_t> baseRows;
+    baseRows.reserve(packs.size());
+    for (size_t i = 0; i < packs.size(); ++i) {
+        baseRows.emplace(packs[i].code, i);
+    }
+
+    NetChanges net;
+    std::vector<Op> ops;
+    size_t lines = 0;
+    size_t badLines = 0;
+    std::string text;
+    while (std::getline(file, text)) {
+        if (text.empty()) continue;
+        ++lines;
+
+        Op op;
+        if (!OpFromLine(text, op)) {
+            ++badLines;
+            continue;
+        }
+        net.Record(op);
+        ops.push_back(std::move(op));
+    }
+    file.close();
+
+    result = ApplyOps(std::move(ops), packs);
+
+    if (badLines > 0) {
+        LOG("SuiteSpot: Skipped {} unreadable line(s) in pack overlay", badLines);
+    }
+    LOG("SuiteSpot: Applied {} pack overlay change(s)", result.applied);
+
+    // Mostly superseded (or damaged) lines: rewrite with one line per changed pack
+    if (lines >= kCompactMinLines && lines > 2 * net.size()) {
+        Compact(overlayPath, net.Ops(baseRows), lines, readGeneration);
+    }
+    return result;
+}
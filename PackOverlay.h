@@ -0,0 +1,87 @@
+#pragma once
+#include "MapList.h"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/*
+ * ======================================================================================
+ * PACK OVERLAY: YOUR CHANGES, KEPT NEXT TO THE CATALOG
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * A small log file (`training_packs.overlay.jsonl`) holding everything you changed on top
+ * of the downloaded catalog: custom packs, edits, deletions and healed shot counts.
+ *
+ * WHY IS IT HERE?
+ * `training_packs.json` is several megabytes. Rewriting all of it because one pack's shot
+ * count was healed is wasteful, and it also got overwritten by the scraper. Now the
+ * downloaded file is left alone and each change costs one short line in the overlay.
+ *
+ * HOW DOES IT WORK?
+ * 1. Every change is appended as one JSON object per line:
+ *      {"op":"upsert","pack":{...}}    add a pack or replace it (by code)
+ *      {"op":"delete","code":"..."}    remove a pack
+ *      {"op":"heal","code":"...","shots":N,"creator":"...","notes":"..."}
+ *                                      set the shot count; creator/notes (optional) only
+ *                                      fill in text that is still blank
+ * 2. At load, `Apply()` replays the lines in order on top of the base catalog. Later
+ *    lines win, so the newest edit to a pack is what you see.
+ * 3. When most lines have been superseded (e.g. the same pack healed many times), the
+ *    file is rewritten with one line per changed pack ("compaction"). Appends and
+ *    compactions share a lock, and a compaction is skipped if anything was appended since
+ *    the file was read, so a line written meanwhile is never dropped.
+ * 4. Broken lines (e.g. a half-written last line after a crash) are skipped.
+ */
+
+namespace PackOverlay
+{
+    struct Op
+    {
+        enum class Kind { Upsert, Delete, Heal };
+
+        Kind kind = Kind::Upsert;
+        TrainingEntry pack;  // Upsert: the whole pack
+        std::string code;    // Delete / Heal
+        int shots = 0;       // Heal
+        std::string creator; // Heal: only fills a blank creator
+        std::string notes;   // Heal: only fills blank notes (when there are no staff comments either)
+
+        static Op Upsert(const TrainingEntry& pack);
+        static Op Delete(const std::string& code);
+        static Op Heal(const std::string& code, int shots, const std::string& creator = {}, const std::string& notes = {});
+
+        const std::string& Code() const { return kind == Kind::Upsert ? pack.code : code; }
+    };
+
+    // What a heal op does to a pack: the shot count is set, text only fills blanks.
+    // Returns true if `pack` changed.
+    bool ApplyHeal(const Op& heal, TrainingEntry& pack);
+
+    // Folds `later` into `earlier` (both for the same pack) so one op has the combined effect
+    void Merge(Op& earlier, const Op& later);
+
+    struct ApplyResult
+    {
+        int applied = 0;         // Lines that changed the catalog
+        bool needsSort = false;  // A pack was added or renamed; name order may be broken
+    };
+
+    // training_packs.json -> training_packs.overlay.jsonl
+    std::filesystem::path PathFor(const std::filesystem::path& jsonPath);
+
+    // Appends `ops` (one line each) to the overlay of `jsonPath`. Returns false and logs on failure.
+    bool Append(const std::filesystem::path& jsonPath, const std::vector<Op>& ops);
+
+    // Writes `ops` at the start of the overlay, before every existing line, so anything
+    // already in the overlay still wins. For moving packs in from the base file.
+    bool Prepend(const std::filesystem::path& jsonPath, const std::vector<Op>& ops);
+
+    // Replays `ops` in order on top of `packs`, as if they had been read from the overlay.
+    // Replaying ops that are already applied is harmless: each one sets a pack's final state.
+    ApplyResult ApplyOps(std::vector<Op> ops, std::vector<TrainingEntry>& packs);
+
+    // Replays the overlay of `jsonPath` on top of `packs` (the base catalog), then compacts
+    // the file if it's mostly superseded lines. A missing overlay is not an error.
+    ApplyResult Apply(const std::filesystem::path& jsonPath, std::vector<TrainingEntry>& packs);
+}
@@ -0,0 +1,417 @@
+#include "pch.h"
+#include "PackScraper.h"
+#include "PackJsonReader.h"
+#include "bakkesmod/wrappers/http/HttpWrapper.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <random>
+#include <unordered_set>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::chrono::milliseconds kCancelPollInterval{200};
+
+    // Same browser user agent the PowerShell updater sent
+    constexpr const char* kUserAgent = "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36";
+
+    // Refills `ratePerSecond` tokens a second, holding at most `capacity`
+    class TokenBucket
+    {
+    public:
+        TokenBucket(double ratePerSecond, double capacity)
+            : rate(std::max(ratePerSecond, 0.1)), capacity(std::max(capacity, 1.0)), tokens(this->capacity),
+              lastRefill(Clock::now()) {}
+
+        // Takes a token if there is one; otherwise says when the next one will be there
+        bool TryTake(Clock::time_point now, Clock::time_point& nextToken)
+        {
+            const std::chrono::duration<double> elapsed = now - lastRefill;
+            tokens = std::min(capacity, tokens + elapsed.count() * rate);
+            lastRefill = now;
+            if (tokens >= 1.0) {
+                tokens -= 1.0;
+                return true;
+            }
+            nextToken = now + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>((1.0 - tokens) / rate));
+            return false;
+        }
+
+    private:
+        double rate;
+        double capacity;
+        double tokens;
+        Clock::time_point lastRefill;
+    };
+
+    // Responses land here from HttpWrapper's threads. Shared so a response arriving after
+    // Run() gave up on it (timeout) still has somewhere safe to go.
+    struct Inbox
+    {
+        struct Response
+        {
+            int requestId = 0;
+            int status = 0;
+            std::string body;
+        };
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::vector<Response> responses;
+    };
+
+    struct PageJob
+    {
+        int page = 0;
+        int attempt = 0;                  // Attempts already made
+        Clock::time_point notBefore;
+    };
+
+    struct InFlight
+    {
+        int page = 0;
+        int attempt = 0;
+        Clock::time_point deadline;
+    };
+
+    std::string PageUrl(const std::string& baseUrl, int page)
+    {
+        const char separator = (baseUrl.find('?') == std::string::npos) ? '?' : '&';
+        return baseUrl + separator + "page=" + std::to_string(page);
+    }
+
+    void SendWithHttpWrapper(const std::string& url, const PackScraper::Headers& headers,
+                             std::function<void(int, std::string)> onDone)
+    {
+        CurlRequest req;
+        req.url = url;
+        req.headers = headers;
+        req.headers["User-Agent"] = kUserAgent;
+        HttpWrapper::SendCurlRequest(req, [onDone = std::move(onDone)](int code, std::string body) {
+            onDone(code, std::move(body));
+        });
+    }
+
+    void AppendUtf8(std::string& out, uint32_t codePoint)
+    {
+        if (codePoint < 0x80) {
+            out += static_cast<char>(codePoint);
+        } else if (codePoint < 0x800) {
+            out += static_cast<char>(0xC0 | (codePoint >> 6));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else if (codePoint < 0x10000) {
+            out += static_cast<char>(0xE0 | (codePoint >> 12));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (codePoint >> 18));
+            out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    // Prejump's fields match the catalog file's, except tags may come as {"name": ...} objects
+    TrainingEntry PackFromPage(const nlohmann::json& object)
+    {
+        TrainingEntry pack = PackJsonReader::FromJson(object);
+        if (pack.tags.empty()) {
+            if (auto tags = object.find("tags"); tags != object.end() && tags->is_array()) {
+                for (const auto& tag : *tags) {
+                    auto name = tag.is_object() ? tag.find("name") : tag.end();
+                    if (tag.is_object() && name != tag.end() && name->is_string()) {
+                        pack.tags.push_back(name->get<std::string>());
+                    }
+                }
+            }
+        }
+        pack.source = "prejump";
+        pack.isModified = false;
+        return pack;
+    }
+}
+
+std::string PackScraper::DecodeHtmlEntities(std::string_view text)
+{
+    static const std::pair<std::string_view, char> kNamed[] = {
+        { "quot", '"' }, { "amp", '&' }, { "lt", '<' }, { "gt", '>' }, { "apos", '\'' }
+    };
+
+    std::string out;
+    out.reserve(text.size());
+    size_t pos = 0;
+    while (pos < text.size()) {
+        const size_t amp = text.find('&', pos);
+        if (amp == std::string_view::npos) {
+            out.append(text.substr(pos));
+            break;
+        }
+        out.append(text.substr(pos, amp - pos));
+
+        const size_t semi = text.find(';', amp);
+        if (semi == std::string_view::npos || semi - amp > 10) {
+            out += '&';  // Not an entity, just an ampersand
+            pos = amp + 1;
+            continue;
+        }
+
+        const std::string_view name = text.substr(amp + 1, semi - amp - 1);
+        bool decoded = false;
+        if (name.size() > 1 && name[0] == '#') {
+            const bool hex = (name[1] == 'x' || name[1] == 'X');
+            const std::string digits(name.substr(hex ? 2 : 1));
+            char* end = nullptr;
+            const unsigned long codePoint = std::strtoul(digits.c_str(), &end, hex ? 16 : 10);
+            if (!digits.empty() && end && *end == '\0' && codePoint > 0 && codePoint <= 0x10FFFF) {
+                AppendUtf8(out, static_cast<uint32_t>(codePoint));
+                decoded = true;
+            }
+        } else {
+            for (const auto& [entity, ch] : kNamed) {
+                if (name == entity) {
+                    out += ch;
+                    decoded = true;
+                    break;
+                }
+            }
+        }
+
+        if (decoded) {
+            pos = semi + 1;
+        } else {
+            out += '&';
+            pos = amp + 1;
+        }
+    }
+    return out;
+}
+
+bool PackScraper::ParsePage(std::string_view html, std::vector<TrainingEntry>& outPacks, int& outLastPage)
+{
+    constexpr std::string_view kAttribute = "data-page=\"";
+    const size_t start = html.find(kAttribute);
+    if (start == std::string_view::npos) return false;
+    const size_t valueStart = start + kAttribute.size();
+    const size_t valueEnd = html.find('"', valueStart);
+    if (valueEnd == std::string_view::npos) return false;
+
+    const auto page = nlohmann::json::parse(DecodeHtmlEntities(html.substr(valueStart, valueEnd - valueStart)),
+                                            nullptr, false);
+    if (page.is_discarded() || !page.is_object()) return false;
+
+    const auto props = page.find("props");
+    if (props == page.end() || !props->is_object()) return false;
+    const auto packs = props->find("packs");
+    if (packs == props->end() || !packs->is_object()) return false;
+    const auto data = packs->find("data");
+    if (data == packs->end() || !data->is_array()) return false;
+
+    outLastPage = 1;
+    if (auto meta = packs->find("meta"); meta != packs->end() && meta->is_object()) {
+        if (auto last = meta->find("last_page"); last != meta->end() && last->is_number_integer()) {
+            outLastPage = std::max(1, last->get<int>());
+        }
+    }
+
+    for (const auto& object : *data) {
+        if (!object.is_object()) continue;
+        TrainingEntry pack = PackFromPage(object);
+        if (!pack.code.empty() && !pack.name.empty()) {
+            outPacks.push_back(std::move(pack));
+        }
+    }
+    return true;
+}
+
+PackScraper::Result PackScraper::Run(const Options& options, const HttpGet& get)
+{
+    const HttpGet send = get ? get : HttpGet(SendWithHttpWrapper);
+    const auto startedAt = Clock::now();
+
+    Result result;
+    std::map<int, std::vector<TrainingEntry>> pagePacks;  // Pages finish in any order
+    const bool quickSync = static_cast<bool>(options.isKnown);
+    int knownRun = 0;                                     // Quick sync: known packs in a row so far
+
+    Progress progress;
+    progress.quickSync = quickSync;
+    auto report = [&]() {
+        if (!options.onProgress) return;
+        progress.pagesTotal = result.pageCount;
+        progress.retries = result.retries;
+        progress.failedPages = static_cast<int>(result.failedPages.size());
+        progress.elapsedSeconds = std::chrono::duration<double>(Clock::now() - startedAt).count();
+        options.onProgress(progress);
+    };
+    std::deque<PageJob> jobs{ PageJob{ 1, 0, startedAt } };
+    std::map<int, InFlight> inFlight;                     // By request id
+    int nextRequestId = 0;
+
+    auto inbox = std::make_shared<Inbox>();
+    TokenBucket bucket(options.requestsPerSecond, options.burst);
+    std::mt19937 rng(std::random_device{}());
+
+    // Failed attempt: try again later, or give up on the page
+    auto retry = [&](int page, int attempt, Clock::time_point now) {
+        if (attempt < options.maxAttempts) {
+            auto delay = options.firstRetryDelay * (1 << std::min(attempt - 1, 6));
+            delay += std::chrono::milliseconds(std::uniform_int_distribution<int>(0, 250)(rng));  // Spread retries out
+            jobs.push_back({ page, attempt, now + delay });
+            ++result.retries;
+        } else {
+            LOG("SuiteSpot: Giving up on pack page {} after {} attempts", page, attempt);
+            result.failedPages.push_back(page);
+        }
+    };
+
+    while (!jobs.empty() || !inFlight.empty()) {
+        if (options.cancel && options.cancel->load()) {
+            result.cancelled = true;
+            break;
+        }
+
+        auto now = Clock::now();
+        // Check the cancel flag a few times a second even when nothing else is due
+        Clock::time_point wakeAt = now + (options.cancel ? kCancelPollInterval : std::chrono::milliseconds(1000));
+
+        // Start whatever the concurrency limit, the retry delays and the rate limit allow
+        while (static_cast<int>(inFlight.size()) < options.maxConcurrent) {
+            auto ready = std::find_if(jobs.begin(), jobs.end(),
+                [now](const PageJob& job) { return job.notBefore <= now; });
+            if (ready == jobs.end()) break;
+
+            Clock::time_point nextToken;
+            if (!bucket.TryTake(now, nextToken)) {
+                wakeAt = std::min(wakeAt, nextToken);
+                break;
+            }
+
+            const PageJob job = *ready;
+            jobs.erase(ready);
+            const int requestId = ++nextRequestId;
+            inFlight[requestId] = { job.page, job.attempt + 1, now + options.requestTimeout };
+
+            Headers headers;
+            if (job.page == 1 && !options.ifModifiedSince.empty()) {
+                headers["If-Modified-Since"] = options.ifModifiedSince;
+            }
+            send(PageUrl(options.baseUrl, job.page), headers, [inbox, requestId](int status, std::string body) {
+                {
+                    std::lock_guard<std::mutex> lock(inbox->mutex);
+                    inbox->responses.push_back({ requestId, status, std::move(body) });
+                }
+                inbox->wake.notify_one();
+            });
+        }
+
+        for (const auto& job : jobs) {
+            wakeAt = std::min(wakeAt, std::max(job.notBefore, now));
+        }
+        for (const auto& [id, request] : inFlight) {
+            wakeAt = std::min(wakeAt, request.deadline);
+        }
+
+        std::vector<Inbox::Response> responses;
+        {
+            std::unique_lock<std::mutex> lock(inbox->mutex);
+            inbox->wake.wait_until(lock, wakeAt, [&inbox]() { return !inbox->responses.empty(); });
+            responses.swap(inbox->responses);
+        }
+        now = Clock::now();
+
+        for (auto& response : responses) {
+            auto it = inFlight.find(response.requestId);
+            if (it == inFlight.end()) continue;  // Already timed out and retried
+            const InFlight request = it->second;
+            inFlight.erase(it);
+
+            if (request.page == 1 && response.status == 304 && !options.ifModifiedSince.empty()) {
+                result.notModified = true;
+                continue;
+            }
+
+            std::vector<TrainingEntry> packs;
+            int lastPage = 0;
+            if (response.status != 200 || !ParsePage(response.body, packs, lastPage)) {
+                LOG("SuiteSpot: Pack page {} failed (HTTP {}), attempt {}", request.page, response.status, request.attempt);
+                retry(request.page, request.attempt, now);
+                continue;
+            }
+
+            ++result.pagesFetched;
+            if (request.page == 1) {
+                result.pageCount = lastPage;
+            }
+            ++progress.pagesDone;
+            progress.packsParsed += static_cast<int>(packs.size());
+            progress.bytesFetched += response.body.size();
+
+            if (quickSync) {
+                // One page in flight at a time, so pages arrive in order and the run carries over
+                for (const auto& pack : packs) {
+                    knownRun = options.isKnown(pack) ? knownRun + 1 : 0;
+                    if (knownRun >= options.stopAfterKnown) break;
+                }
+                if (knownRun >= options.stopAfterKnown) {
+                    result.stoppedEarly = (request.page < result.pageCount);
+                } else if (request.page < result.pageCount) {
+                    jobs.push_back({ request.page + 1, 0, now });
+                }
+            } else if (request.page == 1) {
+                for (int page = 2; page <= lastPage; ++page) {
+                    jobs.push_back({ page, 0, now });
+                }
+            }
+            pagePacks[request.page] = std::move(packs);
+        }
+        if (!responses.empty()) {
+            report();
+        }
+
+        for (auto it = inFlight.begin(); it != inFlight.end();) {
+            if (it->second.deadline <= now) {
+                LOG("SuiteSpot: Pack page {} timed out, attempt {}", it->second.page, it->second.attempt);
+                retry(it->second.page, it->second.attempt, now);
+                it = inFlight.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        // Without page 1 there's no page count, so nothing else can be fetched; and a quick
+        // sync can't skip past a page it couldn't read
+        if ((result.pageCount == 0 || quickSync) && !result.failedPages.empty()) {
+            break;
+        }
+    }
+
+    // Page order, first copy of each code wins (same as the old updater)
+    std::unordered_set<std::string> seenCodes;
+    for (auto& [page, packs] : pagePacks) {
+        for (auto& pack : packs) {
+            if (seenCodes.insert(pack.code).second) {
+                result.packs.push_back(std::move(pack));
+            }
+        }
+    }
+    std::sort(result.failedPages.begin(), result.failedPages.end());
+
+    const std::chrono::duration<double> elapsed = Clock::now() - startedAt;
+    report();
+    if (result.cancelled) {
+        LOG("SuiteSpot: Pack update cancelled after {} page(s) ({:.1f}s)", pagePacks.size(), elapsed.count());
+    } else if (result.notModified) {
+        LOG("SuiteSpot: Pack list unchanged since {} ({:.1f}s)", options.ifModifiedSince, elapsed.count());
+    } else {
+        LOG("SuiteSpot: Scraped {} packs from {} of {} page(s) in {:.1f}s ({} retries, {} failed{})",
+            result.packs.size(), pagePacks.size(), result.pageCount, elapsed.count(), result.retries,
+            result.failedPages.size(), result.stoppedEarly ? ", stopped at known packs" : "");
+    }
+    return result;
+}
@@ -0,0 +1,133 @@
+#pragma once
+#include "MapList.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * ======================================================================================
+ * PACK SCRAPER: DOWNLOADS THE TRAINING PACK LIST
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * Fetches every page of the online training pack list and turns it into `TrainingEntry`
+ * objects, inside the plugin.
+ *
+ * WHY IS IT HERE?
+ * The old updater wrote a PowerShell script to the temp folder, ran it through `cmd.exe`
+ * and then read the JSON it wrote. It fetched ~230 pages one at a time with a pause after
+ * each, so an update took 2-3 minutes, and any machine with PowerShell locked down
+ * couldn't update at all.
+ *
+ * HOW DOES IT WORK?
+ * 1. Page 1 is fetched first; it says how many pages there are.
+ * 2. The rest are fetched a few at a time (`maxConcurrent`), and a token bucket keeps the
+ *    overall request rate polite (`requestsPerSecond`, with a small `burst`).
+ * 3. A page that fails (HTTP error, timeout, unreadable HTML) is retried after a delay
+ *    that doubles each time, up to `maxAttempts`.
+ * 4. Each page's HTML carries the pack list as JSON in its `data-page="..."` attribute.
+ *    `ParsePage()` decodes the HTML entities and reads `props.packs.data` with the same
+ *    field rules as the catalog file.
+ * 5. Packs come back in page order with duplicate codes removed. If any page never came
+ *    through, the result is marked incomplete so the caller doesn't treat the missing
+ *    packs as deleted.
+ *
+ * QUICK SYNC:
+ * With `isKnown` set, pages are fetched one at a time from page 1 (the newest packs) and
+ * the walk stops after `stopAfterKnown` packs in a row that `isKnown` says are already in
+ * the catalog unchanged. With `ifModifiedSince` set, page 1 is a conditional request and a
+ * 304 answer (`notModified`) ends the sync after one request. A quick sync can't see
+ * removed packs and misses edits to older packs; a full run picks those up.
+ * (HttpWrapper doesn't hand back response headers, so ETags can't be used.)
+ *
+ * PROGRESS AND CANCELLING:
+ * `onProgress` gets a `Progress` snapshot after every page (pages, packs, bytes, rate, ETA,
+ * failures), on the thread running `Run()`. Setting the atomic `cancel` points at makes
+ * `Run()` stop sending requests and return within a fraction of a second with `cancelled`
+ * set; responses still on their way are dropped.
+ *
+ * `Run()` blocks, so call it from a worker thread. Requests go through an `HttpGet`
+ * function (BakkesMod's HttpWrapper by default); pointing `baseUrl` at a local server
+ * that replays saved pages is enough to test it offline.
+ */
+
+class PackScraper
+{
+public:
+    static constexpr const char* kDefaultSourceUrl = "https://prejump.com/training-packs";
+
+    using Headers = std::map<std::string, std::string>;
+
+    // Fetches `url` with extra request `headers` and calls `onDone(httpStatus, body)` exactly
+    // once, from any thread
+    using HttpGet = std::function<void(const std::string& url, const Headers& headers,
+                                       std::function<void(int, std::string)> onDone)>;
+
+    struct Progress
+    {
+        int pagesDone = 0;
+        int pagesTotal = 0;          // 0 until page 1 arrives; a quick sync usually stops well short
+        int packsParsed = 0;
+        uint64_t bytesFetched = 0;
+        int retries = 0;             // Failed attempts that were tried again
+        int failedPages = 0;         // Gave up on these
+        double elapsedSeconds = 0.0;
+        bool quickSync = false;
+
+        double PagesPerSecond() const { return elapsedSeconds > 0.0 ? pagesDone / elapsedSeconds : 0.0; }
+
+        // Seconds left at the current rate; negative while unknown
+        double EtaSeconds() const
+        {
+            const double rate = PagesPerSecond();
+            return (pagesTotal > 0 && rate > 0.0) ? (pagesTotal - pagesDone - failedPages) / rate : -1.0;
+        }
+    };
+
+    struct Options
+    {
+        std::string baseUrl = kDefaultSourceUrl;
+        int maxConcurrent = 6;                              // Requests in flight at once
+        double requestsPerSecond = 10.0;                    // Long-run request rate
+        int burst = 4;                                      // Requests allowed back to back
+        int maxAttempts = 4;                                // Per page, first try included
+        std::chrono::milliseconds firstRetryDelay{500};     // Doubles with each retry
+        std::chrono::seconds requestTimeout{30};            // Counts as a failed attempt
+
+        // Quick sync (see above); leave empty for a full run
+        std::function<bool(const TrainingEntry&)> isKnown;  // Already in the catalog, unchanged
+        int stopAfterKnown = 30;                            // Known packs in a row that end the walk
+        std::string ifModifiedSince;                        // HTTP date sent with page 1
+
+        std::function<void(const Progress&)> onProgress;    // After every page
+        const std::atomic<bool>* cancel = nullptr;          // Set to true to stop early
+    };
+
+    struct Result
+    {
+        std::vector<TrainingEntry> packs;  // Page order, first copy of each code
+        int pageCount = 0;                 // From page 1; 0 if page 1 never loaded (or notModified)
+        int pagesFetched = 0;
+        int retries = 0;
+        std::vector<int> failedPages;      // Gave up on these after maxAttempts
+        bool notModified = false;          // Page 1 answered 304: nothing new since ifModifiedSince
+        bool stoppedEarly = false;         // Quick sync reached known packs before the last page
+        bool cancelled = false;            // Options::cancel was set
+
+        // Every page that was needed came through (all of them, or up to the known packs)
+        bool Complete() const { return (pageCount > 0 || notModified) && failedPages.empty() && !cancelled; }
+    };
+
+    static Result Run(const Options& options, const HttpGet& get = nullptr);
+
+    // Reads one page's HTML. Returns false if there's no pack list in it.
+    static bool ParsePage(std::string_view html, std::vector<TrainingEntry>& outPacks, int& outLastPage);
+
+    // &quot; &amp; &#39; &#x2F; ... -> the characters they stand for (UTF-8)
+    static std::string DecodeHtmlEntities(std::string_view text);
+};
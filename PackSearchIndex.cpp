@@ -0,0 +1,189 @@
+#include "pch.h"
+#include "PackSearchIndex.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace
+{
+    uint32_t GramKey(const std::string& text, size_t pos)
+    {
+        return (static_cast<uint32_t>(static_cast<unsigned char>(text[pos])) << 16) |
+               (static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 1])) << 8) |
+               static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 2]));
+    }
+}
+
+std::string PackSearchIndex::NormalizeName(std::string_view name)
+{
+    std::string out(name);
+    std::transform(out.begin(), out.end(), out.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return out;
+}
+
+void PackSearchIndex::Clear()
+{
+    names.clear();
+    codes.clear();
+    codeValid.clear();
+    nameGrams.clear();
+}
+
+void PackSearchIndex::Build(const std::vector<TrainingEntry>& packs)
+{
+    Clear();
+    names.reserve(packs.size());
+    codes.reserve(packs.size());
+    codeValid.reserve(packs.size());
+
+    for (int row = 0; row < static_cast<int>(packs.size()); ++row) {
+        names.push_back(NormalizeName(packs[row].name));
+        AddGrams(nameGrams, names.back(), row);
+
+        PackCode code;
+        codeValid.push_back(PackCode::Parse(packs[row].code, code) ? 1 : 0);
+        codes.push_back(code);
+    }
+}
+
+void PackSearchIndex::InsertRow(int row, const TrainingEntry& pack)
+{
+    if (row < 0 || row > static_cast<int>(names.size())) return;
+
+    ShiftRows(nameGrams, row, 1);
+
+    names.insert(names.begin() + row, NormalizeName(pack.name));
+    AddGrams(nameGrams, names[row], row);
+
+    PackCode code;
+    codeValid.insert(codeValid.begin() + row, PackCode::Parse(pack.code, code) ? 1 : 0);
+    codes.insert(codes.begin() + row, code);
+}
+
+void PackSearchIndex::EraseRow(int row)
+{
+    if (row < 0 || row >= static_cast<int>(names.size())) return;
+
+    RemoveGrams(nameGrams, names[row], row);
+    names.erase(names.begin() + row);
+    codes.erase(codes.begin() + row);
+    codeValid.erase(codeValid.begin() + row);
+
+    ShiftRows(nameGrams, row + 1, -1);
+}
+
+void PackSearchIndex::Find(std::string_view query, std::vector<int>& outRows) const
+{
+    outRows.clear();
+
+    std::vector<int> nameRows;
+    std::vector<int> codeRows;
+    FindIn(nameGrams, names, NormalizeName(query), nameRows);
+    FindCodes(query, codeRows);
+
+    outRows.reserve(nameRows.size() + codeRows.size());
+    std::set_union(nameRows.begin(), nameRows.end(), codeRows.begin(), codeRows.end(),
+        std::back_inserter(outRows));
+}
+
+void PackSearchIndex::AddGrams(GramMap& grams, const std::string& text, int row)
+{
+    for (size_t i = 0; i + 3 <= text.size(); ++i) {
+        Postings& list = grams[GramKey(text, i)];
+        auto it = std::lower_bound(list.begin(), list.end(), row);
+        if (it == list.end() || *it != row) {
+            list.insert(it, row);
+        }
+    }
+}
+
+void PackSearchIndex::RemoveGrams(GramMap& grams, const std::string& text, int row)
+{
+    for (size_t i = 0; i + 3 <= text.size(); ++i) {
+        auto found = grams.find(GramKey(text, i));
+        if (found == grams.end()) continue;
+
+        Postings& list = found->second;
+        auto it = std::lower_bound(list.begin(), list.end(), row);
+        if (it != list.end() && *it == row) {
+            list.erase(it);
+        }
+        if (list.empty()) {
+            grams.erase(found);
+        }
+    }
+}
+
+void PackSearchIndex::ShiftRows(GramMap& grams, int fromRow, int delta)
+{
+    for (auto& [key, list] : grams) {
+        for (auto it = std::lower_bound(list.begin(), list.end(), fromRow); it != list.end(); ++it) {
+            *it += delta;
+        }
+    }
+}
+
+void PackSearchIndex::FindIn(const GramMap& grams, const std::vector<std::string>& texts,
+                             const std::string& query, std::vector<int>& outRows)
+{
+    outRows.clear();
+    const int rowCount = static_cast<int>(texts.size());
+
+    // Too short to form a trigram: scan the pre-normalized strings instead
+    if (query.size() < 3) {
+        for (int row = 0; row < rowCount; ++row) {
+            if (texts[row].find(query) != std::string::npos) {
+                outRows.push_back(row);
+            }
+        }
+        return;
+    }
+
+    std::vector<const Postings*> lists;
+    lists.reserve(query.size() - 2);
+    for (size_t i = 0; i + 3 <= query.size(); ++i) {
+        auto found = grams.find(GramKey(query, i));
+        if (found == grams.end()) {
+            return;  // A trigram nobody has means nothing can match
+        }
+        lists.push_back(&found->second);
+    }
+
+    // Intersect starting from the shortest list to keep the working set small
+    std::sort(lists.begin(), lists.end(),
+        [](const Postings* a, const Postings* b) { return a->size() < b->size(); });
+
+    std::vector<int> candidates(*lists.front());
+    std::vector<int> scratch;
+    for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+        if (lists[i] == lists[i - 1]) continue;
+        scratch.clear();
+        std::set_intersection(candidates.begin(), candidates.end(),
+            lists[i]->begin(), lists[i]->end(), std::back_inserter(scratch));
+        candidates.swap(scratch);
+    }
+
+    // Trigrams can match out of order, so confirm the real substring
+    for (int row : candidates) {
+        if (texts[row].find(query) != std::string::npos) {
+            outRows.push_back(row);
+        }
+    }
+}
+
+void PackSearchIndex::FindCodes(std::string_view query, std::vector<int>& outRows) const
+{
+    outRows.clear();
+
+    // Anything but hex digits and dashes can't be part of a code
+    uint64_t digits = 0;
+    int digitCount = 0;
+    if (!PackCode::ParseDigits(query, digits, digitCount)) return;
+
+    for (int row = 0; row < static_cast<int>(codes.size()); ++row) {
+        if (codeValid[row] && codes[row].ContainsDigits(digits, digitCount)) {
+            outRows.push_back(row);
+        }
+    }
+}
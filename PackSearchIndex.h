@@ -0,0 +1,66 @@
+#pragma once
+#include "MapList.h"
+#include "PackCode.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * ======================================================================================
+ * PACK SEARCH INDEX: THE CARD CATALOG
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * A trigram (3-letter chunk) index over every pack's name, plus every pack's code as a
+ * number, used by the browser's search box.
+ *
+ * WHY IS IT HERE?
+ * Scanning 2000+ packs and lowercasing every name on each keystroke gets slower as the
+ * catalog grows. Looking up a few short lists of row numbers does not.
+ *
+ * HOW DOES IT WORK?
+ * 1. Names are lowercased once, when a pack enters the index.
+ * 2. Every 3-character window of a name maps to a sorted list of catalog rows.
+ * 3. `Find()` intersects the lists for the query's trigrams, then confirms each
+ *    candidate with a real substring check. Queries shorter than 3 characters fall
+ *    back to scanning the pre-normalized strings (still no allocations).
+ * 4. Codes are kept as `PackCode` numbers. If the query is all hex digits (dashes
+ *    allowed), each code is checked with a few shift-and-mask compares instead.
+ *
+ * Rows are positions in TrainingPackManager's sorted pack vector. The manager calls
+ * `InsertRow()` / `EraseRow()` whenever that vector changes so the rows stay aligned.
+ */
+
+class PackSearchIndex
+{
+public:
+    void Build(const std::vector<TrainingEntry>& packs);
+    void Clear();
+
+    // Keep the index aligned with the catalog after a single insert/erase
+    void InsertRow(int row, const TrainingEntry& pack);
+    void EraseRow(int row);
+
+    // Rows (ascending) whose name or dashless code contains `query`, case-insensitive
+    void Find(std::string_view query, std::vector<int>& outRows) const;
+
+    static std::string NormalizeName(std::string_view name);
+
+private:
+    using Postings = std::vector<int>;
+    using GramMap = std::unordered_map<uint32_t, Postings>;
+
+    static void AddGrams(GramMap& grams, const std::string& text, int row);
+    static void RemoveGrams(GramMap& grams, const std::string& text, int row);
+    static void ShiftRows(GramMap& grams, int fromRow, int delta);
+    static void FindIn(const GramMap& grams, const std::vector<std::string>& texts,
+                       const std::string& query, std::vector<int>& outRows);
+    void FindCodes(std::string_view query, std::vector<int>& outRows) const;
+
+    std::vector<std::string> names;  // Lowercased names, indexed by row
+    std::vector<PackCode> codes;     // Parsed codes, indexed by row
+    std::vector<uint8_t> codeValid;  // 0 where the code isn't 16 hex digits (never matches)
+    GramMap nameGrams;
+};
@@ -0,0 +1,321 @@
+#include "pch.h"
+#include "PackSnapshot.h"
+
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <unordered_map>
+
+namespace
+{
+    constexpr uint32_t kMagic = 0x4B505353;  // "SSPK" little-endian
+    constexpr uint32_t kVersion = 1;
+
+    struct StrRef
+    {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct FileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t recordCount;
+        uint32_t tagRefCount;
+        uint64_t sourceSize;        // training_packs.json size in bytes
+        int64_t sourceWriteTime;    // training_packs.json last_write_time ticks
+        uint64_t stringTableSize;
+        uint64_t checksum;          // FNV-1a over everything after the header
+    };
+
+    struct PackRecord
+    {
+        StrRef code;
+        StrRef name;
+        StrRef creator;
+        StrRef creatorSlug;
+        StrRef difficulty;
+        StrRef staffComments;
+        StrRef notes;
+        StrRef videoUrl;
+        StrRef source;
+        uint32_t firstTag;          // Index into the tag reference table
+        uint32_t tagCount;
+        int32_t shotCount;
+        int32_t likes;
+        int32_t plays;
+        int32_t status;
+        uint32_t isModified;
+    };
+
+    static_assert(sizeof(FileHeader) == 48, "Snapshot header layout changed; bump kVersion");
+    static_assert(sizeof(PackRecord) == 100, "Snapshot record layout changed; bump kVersion");
+
+    uint64_t Fnv1a(const uint8_t* data, size_t size)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ data[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    bool GetSourceStamp(const std::filesystem::path& jsonPath, uint64_t& size, int64_t& writeTime)
+    {
+        std::error_code ec;
+        size = std::filesystem::file_size(jsonPath, ec);
+        if (ec) return false;
+        auto time = std::filesystem::last_write_time(jsonPath, ec);
+        if (ec) return false;
+        writeTime = static_cast<int64_t>(time.time_since_epoch().count());
+        return true;
+    }
+
+    // Read-only view of a whole file, unmapped on destruction
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::filesystem::path& path)
+        {
+            file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) return;
+
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) return;
+
+            mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping) return;
+
+            view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (view) {
+                size = static_cast<size_t>(fileSize.QuadPart);
+            }
+        }
+
+        ~MappedFile()
+        {
+            if (view) UnmapViewOfFile(view);
+            if (mapping) CloseHandle(mapping);
+            if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const uint8_t* data() const { return static_cast<const uint8_t*>(view); }
+        size_t bytes() const { return size; }
+
+    private:
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+        void* view = nullptr;
+        size_t size = 0;
+    };
+
+    // Identical strings (tags, difficulties, sources, creators) are stored once
+    class StringTableWriter
+    {
+    public:
+        StrRef Add(const std::string& text)
+        {
+            auto [it, inserted] = seen.try_emplace(text, StrRef{ static_cast<uint32_t>(table.size()),
+                                                                 static_cast<uint32_t>(text.size()) });
+            if (inserted) {
+                table.append(text);
+            }
+            return it->second;
+        }
+
+        const std::string& Data() const { return table; }
+
+    private:
+        std::string table;
+        std::unordered_map<std::string, StrRef> seen;
+    };
+}
+
+std::filesystem::path PackSnapshot::PathFor(const std::filesystem::path& jsonPath)
+{
+    std::filesystem::path binPath = jsonPath;
+    binPath.replace_extension(".bin");
+    return binPath;
+}
+
+bool PackSnapshot::Read(const std::filesystem::path& jsonPath, std::vector<TrainingEntry>& outPacks)
+{
+    outPacks.clear();
+
+    uint64_t sourceSize = 0;
+    int64_t sourceWriteTime = 0;
+    if (!GetSourceStamp(jsonPath, sourceSize, sourceWriteTime)) return false;
+
+    const auto binPath = PathFor(jsonPath);
+    std::error_code ec;
+    if (!std::filesystem::exists(binPath, ec)) return false;
+
+    MappedFile mapped(binPath);
+    if (mapped.bytes() < sizeof(FileHeader)) {
+        LOG("SuiteSpot: Pack snapshot unreadable, falling back to JSON");
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, mapped.data(), sizeof(header));
+    if (header.magic != kMagic || header.version != kVersion) {
+        LOG("SuiteSpot: Pack snapshot has an old format, falling back to JSON");
+        return false;
+    }
+    if (header.sourceSize != sourceSize || header.sourceWriteTime != sourceWriteTime) {
+        LOG("SuiteSpot: Pack snapshot is out of date with training_packs.json, falling back to JSON");
+        return false;
+    }
+
+    const uint64_t recordBytes = uint64_t{header.recordCount} * sizeof(PackRecord);
+    const uint64_t tagBytes = uint64_t{header.tagRefCount} * sizeof(StrRef);
+    const uint64_t expected = sizeof(FileHeader) + recordBytes + tagBytes + header.stringTableSize;
+    if (expected != mapped.bytes()) {
+        LOG("SuiteSpot: Pack snapshot size mismatch, falling back to JSON");
+        return false;
+    }
+
+    const uint8_t* payload = mapped.data() + sizeof(FileHeader);
+    if (Fnv1a(payload, mapped.bytes() - sizeof(FileHeader)) != header.checksum) {
+        LOG("SuiteSpot: Pack snapshot checksum mismatch, falling back to JSON");
+        return false;
+    }
+
+    const uint8_t* recordBase = payload;
+    const uint8_t* tagBase = recordBase + recordBytes;
+    const char* strings = reinterpret_cast<const char*>(tagBase + tagBytes);
+    const uint64_t stringsSize = header.stringTableSize;
+
+    bool valid = true;
+    auto text = [strings, stringsSize, &valid](StrRef ref) -> std::string {
+        if (uint64_t{ref.offset} + ref.length > stringsSize) {
+            valid = false;
+            return {};
+        }
+        return std::string(strings + ref.offset, ref.length);
+    };
+
+    outPacks.reserve(header.recordCount);
+    for (uint32_t i = 0; i < header.recordCount && valid; ++i) {
+        PackRecord record;
+        std::memcpy(&record, recordBase + uint64_t{i} * sizeof(PackRecord), sizeof(record));
+
+        TrainingEntry entry;
+        entry.code = text(record.code);
+        entry.name = text(record.name);
+        entry.creator = text(record.creator);
+        entry.creatorSlug = text(record.creatorSlug);
+        entry.difficulty = text(record.difficulty);
+        entry.staffComments = text(record.staffComments);
+        entry.notes = text(record.notes);
+        entry.videoUrl = text(record.videoUrl);
+        entry.source = text(record.source);
+        entry.shotCount = record.shotCount;
+        entry.likes = record.likes;
+        entry.plays = record.plays;
+        entry.status = record.status;
+        entry.isModified = record.isModified != 0;
+
+        if (uint64_t{record.firstTag} + record.tagCount > header.tagRefCount) {
+            valid = false;
+            break;
+        }
+        entry.tags.reserve(record.tagCount);
+        for (uint32_t t = 0; t < record.tagCount; ++t) {
+            StrRef ref;
+            std::memcpy(&ref, tagBase + uint64_t{record.firstTag + t} * sizeof(StrRef), sizeof(ref));
+            entry.tags.push_back(text(ref));
+        }
+
+        outPacks.push_back(std::move(entry));
+    }
+
+    if (!valid) {
+        LOG("SuiteSpot: Pack snapshot has out-of-range entries, falling back to JSON");
+        outPacks.clear();
+        return false;
+    }
+    return true;
+}
+
+bool PackSnapshot::Write(const std::filesystem::path& jsonPath, const std::vector<TrainingEntry>& packs)
+{
+    try {
+        FileHeader header{};
+        header.magic = kMagic;
+        header.version = kVersion;
+        if (!GetSourceStamp(jsonPath, header.sourceSize, header.sourceWriteTime)) {
+            return false;
+        }
+
+        StringTableWriter strings;
+        std::vector<PackRecord> records;
+        std::vector<StrRef> tagRefs;
+        records.reserve(packs.size());
+
+        for (const auto& pack : packs) {
+            PackRecord record{};
+            record.code = strings.Add(pack.code);
+            record.name = strings.Add(pack.name);
+            record.creator = strings.Add(pack.creator);
+            record.creatorSlug = strings.Add(pack.creatorSlug);
+            record.difficulty = strings.Add(pack.difficulty);
+            record.staffComments = strings.Add(pack.staffComments);
+            record.notes = strings.Add(pack.notes);
+            record.videoUrl = strings.Add(pack.videoUrl);
+            record.source = strings.Add(pack.source);
+            record.firstTag = static_cast<uint32_t>(tagRefs.size());
+            record.tagCount = static_cast<uint32_t>(pack.tags.size());
+            for (const auto& tag : pack.tags) {
+                tagRefs.push_back(strings.Add(tag));
+            }
+            record.shotCount = pack.shotCount;
+            record.likes = pack.likes;
+            record.plays = pack.plays;
+            record.status = pack.status;
+            record.isModified = pack.isModified ? 1u : 0u;
+            records.push_back(record);
+        }
+
+        header.recordCount = static_cast<uint32_t>(records.size());
+        header.tagRefCount = static_cast<uint32_t>(tagRefs.size());
+        header.stringTableSize = strings.Data().size();
+
+        std::string payload;
+        payload.reserve(records.size() * sizeof(PackRecord) + tagRefs.size() * sizeof(StrRef) + strings.Data().size());
+        payload.append(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(PackRecord));
+        payload.append(reinterpret_cast<const char*>(tagRefs.data()), tagRefs.size() * sizeof(StrRef));
+        payload.append(strings.Data());
+        header.checksum = Fnv1a(reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+
+        const auto binPath = PathFor(jsonPath);
+        auto tempPath = binPath;
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                LOG("SuiteSpot: Failed to write pack snapshot: {}", tempPath.string());
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+            if (!file) {
+                LOG("SuiteSpot: Failed to write pack snapshot: {}", tempPath.string());
+                return false;
+            }
+        }
+        std::filesystem::rename(tempPath, binPath);
+
+        LOG("SuiteSpot: Wrote pack snapshot ({} packs)", records.size());
+        return true;
+
+    } catch (const std::exception& e) {
+        LOG("SuiteSpot: Error writing pack snapshot: {}", std::string(e.what()));
+        return false;
+    }
+}
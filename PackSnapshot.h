@@ -0,0 +1,44 @@
+#pragma once
+#include "MapList.h"
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+/*
+ * ======================================================================================
+ * PACK SNAPSHOT: THE QUICK-START COPY OF training_packs.json
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * A binary copy of the pack catalog (`training_packs.bin`) saved right next to
+ * `training_packs.json`.
+ *
+ * WHY IS IT HERE?
+ * The JSON file is several megabytes of pretty-printed text. Parsing it into a JSON tree
+ * and then copying that into packs is the slowest part of plugin startup. The snapshot
+ * is memory-mapped and read straight into packs, already sorted by name.
+ *
+ * HOW DOES IT WORK?
+ * 1. Layout: a fixed header, then fixed-width pack records, then the tag reference
+ *    table, then one string table holding every piece of text. Records point into the
+ *    string table by (offset, length).
+ * 2. The header stores the JSON file's size and write time. If the JSON changed (e.g. the
+ *    scraper rewrote it) the snapshot is stale and ignored.
+ * 3. A checksum over everything after the header catches truncated or corrupted files.
+ * 4. Any failure just means "load the JSON instead"; TrainingPackManager then writes a
+ *    fresh snapshot so the next startup is fast again.
+ */
+
+namespace PackSnapshot
+{
+    // training_packs.json -> training_packs.bin
+    std::filesystem::path PathFor(const std::filesystem::path& jsonPath);
+
+    // Fills `outPacks` (in stored order) if the snapshot exists, is intact and matches
+    // the current JSON file. Returns false otherwise and leaves `outPacks` empty.
+    bool Read(const std::filesystem::path& jsonPath, std::vector<TrainingEntry>& outPacks);
+
+    // Writes a snapshot of `packs` (expected to be name-sorted) stamped with the JSON
+    // file's current size and write time. Written to a temp file first, then swapped in.
+    bool Write(const std::filesystem::path& jsonPath, const std::vector<TrainingEntry>& packs);
+}
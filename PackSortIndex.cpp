@@ -0,0 +1,194 @@
+#include "pch.h"
+#include "PackSortIndex.h"
+
+#include <algorithm>
+#include <numeric>
+
+int PackSortIndex::Compare(const PackColumns& columns, int column, int rowA, int rowB)
+{
+    auto compareValues = [rowA, rowB](const auto& values) -> int {
+        return (values[rowA] < values[rowB]) ? -1 : (values[rowA] > values[rowB]) ? 1 : 0;
+    };
+
+    switch (column) {
+        case Name:       return columns.CompareName(rowA, rowB);
+        case Creator:    return columns.CompareCreator(rowA, rowB);
+        case Difficulty: return compareValues(columns.difficultyRank);
+        case Shots:      return compareValues(columns.shots);
+        case Likes:      return compareValues(columns.likes);
+        case Plays:      return compareValues(columns.plays);
+    }
+    return 0;
+}
+
+void PackSortIndex::Clear()
+{
+    for (int c = 0; c < ColumnCount; ++c) {
+        order[c].clear();
+        ranks[c].clear();
+        rankCount[c] = 0;
+    }
+}
+
+void PackSortIndex::Build(const PackColumns& columns)
+{
+    const int rowCount = static_cast<int>(columns.size());
+    for (int c = 0; c < ColumnCount; ++c) {
+        order[c].resize(rowCount);
+        std::iota(order[c].begin(), order[c].end(), 0);
+        std::sort(order[c].begin(), order[c].end(), [&columns, c](int a, int b) {
+            const int cmp = Compare(columns, c, a, b);
+            return cmp < 0 || (cmp == 0 && a < b);
+        });
+        RebuildRanks(c, columns);
+    }
+}
+
+void PackSortIndex::InsertRow(int row, const PackColumns& columns)
+{
+    for (int c = 0; c < ColumnCount; ++c) {
+        for (int& existing : order[c]) {
+            existing += (existing >= row);
+        }
+        InsertSorted(c, row, columns);
+        RebuildRanks(c, columns);
+    }
+}
+
+void PackSortIndex::EraseRow(int row, const PackColumns& columns)
+{
+    for (int c = 0; c < ColumnCount; ++c) {
+        auto& list = order[c];
+        list.erase(std::remove(list.begin(), list.end(), row), list.end());
+        for (int& existing : list) {
+            existing -= (existing > row);
+        }
+        RebuildRanks(c, columns);
+    }
+}
+
+void PackSortIndex::UpdateRow(int column, int row, const PackColumns& columns)
+{
+    if (column < 0 || column >= ColumnCount) return;
+
+    auto& list = order[column];
+    list.erase(std::remove(list.begin(), list.end(), row), list.end());
+    InsertSorted(column, row, columns);
+    RebuildRanks(column, columns);
+}
+
+void PackSortIndex::InsertSorted(int column, int row, const PackColumns& columns)
+{
+    auto& list = order[column];
+    auto pos = std::lower_bound(list.begin(), list.end(), row, [&columns, column](int existing, int newRow) {
+        const int cmp = Compare(columns, column, existing, newRow);
+        return cmp < 0 || (cmp == 0 && existing < newRow);
+    });
+    list.insert(pos, row);
+}
+
+void PackSortIndex::RebuildRanks(int column, const PackColumns& columns)
+{
+    const auto& list = order[column];
+    auto& rank = ranks[column];
+    rank.assign(list.size(), 0);
+
+    uint32_t current = 0;
+    for (size_t i = 0; i < list.size(); ++i) {
+        if (i > 0 && Compare(columns, column, list[i - 1], list[i]) != 0) {
+            ++current;
+        }
+        rank[list[i]] = current;
+    }
+    rankCount[column] = list.empty() ? 0 : current + 1;
+}
+
+void PackSortIndex::Collect(int column, bool ascending, const PackBitmap& keep,
+                            std::vector<int>& out) const
+{
+    out.clear();
+    if (column < 0 || column >= ColumnCount) column = Name;
+    const auto& list = order[column];
+    const auto& rank = ranks[column];
+
+    if (ascending) {
+        for (int row : list) {
+            if (keep.Test(row)) out.push_back(row);
+        }
+        return;
+    }
+
+    // Walk groups of equal values from the top down, but keep each group in name order
+    for (size_t end = list.size(); end > 0;) {
+        size_t start = end - 1;
+        while (start > 0 && rank[list[start - 1]] == rank[list[end - 1]]) {
+            --start;
+        }
+        for (size_t i = start; i < end; ++i) {
+            if (keep.Test(list[i])) out.push_back(list[i]);
+        }
+        end = start;
+    }
+}
+
+void PackSortIndex::CollectTwoKey(int primary, bool primaryAscending, int secondary, bool secondaryAscending,
+                                  const PackBitmap& keep, std::vector<int>& out) const
+{
+    if (primary < 0 || primary >= ColumnCount) primary = Name;
+    if (secondary < 0 || secondary >= ColumnCount || secondary == primary) {
+        Collect(primary, primaryAscending, keep, out);
+        return;
+    }
+
+    // Composite key: primary rank in the high half, secondary rank in the low half.
+    // Descending columns flip their rank so a single ascending sort handles both.
+    const auto& primaryRank = ranks[primary];
+    const auto& secondaryRank = ranks[secondary];
+    const uint32_t primaryTop = rankCount[primary] ? rankCount[primary] - 1 : 0;
+    const uint32_t secondaryTop = rankCount[secondary] ? rankCount[secondary] - 1 : 0;
+
+    struct Item
+    {
+        uint64_t key;
+        int row;
+    };
+    std::vector<Item> items;
+    std::vector<Item> scratch;
+    items.reserve(keep.Count());
+    keep.ForEach([&](int row) {
+        const uint64_t high = primaryAscending ? primaryRank[row] : primaryTop - primaryRank[row];
+        const uint64_t low = secondaryAscending ? secondaryRank[row] : secondaryTop - secondaryRank[row];
+        items.push_back({ (high << 32) | low, row });
+    });
+    scratch.resize(items.size());
+
+    // LSD radix sort, 16 bits per pass. Items start in row (name) order and every pass is
+    // stable, so full ties stay alphabetical. Passes where every digit matches are skipped.
+    std::vector<uint32_t> counts(1u << 16);
+    for (int shift = 0; shift < 64; shift += 16) {
+        std::fill(counts.begin(), counts.end(), 0);
+        for (const Item& item : items) {
+            ++counts[(item.key >> shift) & 0xFFFF];
+        }
+        if (!items.empty() && counts[(items.front().key >> shift) & 0xFFFF] == items.size()) {
+            continue;
+        }
+
+        uint32_t total = 0;
+        for (uint32_t& count : counts) {
+            const uint32_t c = count;
+            count = total;
+            total += c;
+        }
+        for (const Item& item : items) {
+            scratch[counts[(item.key >> shift) & 0xFFFF]++] = item;
+        }
+        items.swap(scratch);
+    }
+
+    out.clear();
+    out.reserve(items.size());
+    for (const Item& item : items) {
+        out.push_back(item.row);
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "PackColumns.h"
+#include <cstdint>
+#include <vector>
+
+/*
+ * ======================================================================================
+ * PACK SORT INDEX: THE PRE-SORTED SHELVES
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * For every sortable browser column (Name, Creator, Difficulty, Shots, Likes, Plays) this
+ * keeps the whole catalog already sorted by that column.
+ *
+ * WHY IS IT HERE?
+ * Clicking a column header used to re-sort the filtered list from scratch. With the
+ * order already known, a sorted result is one pass down the right list, keeping the
+ * rows that passed the filters.
+ *
+ * HOW DOES IT WORK?
+ * 1. `order[c]` holds every catalog row sorted ascending by column `c`. Ties fall back
+ *    to row number, which is name order, so equal values always list alphabetically.
+ * 2. `ranks[c][row]` is that row's dense position in column `c` (equal values share a
+ *    rank). Descending walks and two-key sorts work on these integers only.
+ * 3. Two-key sorts (e.g. Difficulty, then Likes) pack both ranks into one 64-bit number
+ *    and radix sort those; no string or nested comparator is involved.
+ * 4. The manager calls `InsertRow()` / `EraseRow()` / `UpdateRow()` on every catalog
+ *    change, after `PackColumns` has been updated.
+ */
+
+class PackSortIndex
+{
+public:
+    // Matches the browser's sort column ids
+    enum Column
+    {
+        Name = 0,
+        Creator = 1,
+        Difficulty = 2,
+        Shots = 3,
+        Likes = 4,
+        Plays = 5,
+        ColumnCount
+    };
+
+    void Build(const PackColumns& columns);
+    void Clear();
+
+    // `columns` must already reflect the change
+    void InsertRow(int row, const PackColumns& columns);
+    void EraseRow(int row, const PackColumns& columns);
+    void UpdateRow(int column, int row, const PackColumns& columns);
+
+    // Rows whose `keep` bit is set, in the requested order
+    void Collect(int column, bool ascending, const PackBitmap& keep,
+                 std::vector<int>& out) const;
+    void CollectTwoKey(int primary, bool primaryAscending, int secondary, bool secondaryAscending,
+                       const PackBitmap& keep, std::vector<int>& out) const;
+
+private:
+    static int Compare(const PackColumns& columns, int column, int rowA, int rowB);
+    void InsertSorted(int column, int row, const PackColumns& columns);
+    void RebuildRanks(int column, const PackColumns& columns);
+
+    std::vector<int> order[ColumnCount];
+    std::vector<uint32_t> ranks[ColumnCount];
+    uint32_t rankCount[ColumnCount] = {};  // Number of distinct values per column
+};
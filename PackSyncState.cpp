@@ -0,0 +1,72 @@
+#include "pch.h"
+#include "PackSyncState.h"
+#include "IMGUI/json.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <locale>
+#include <sstream>
+
+std::filesystem::path PackSyncState::PathFor(const std::filesystem::path& jsonPath)
+{
+    std::filesystem::path syncPath = jsonPath;
+    syncPath.replace_extension(".sync.json");
+    return syncPath;
+}
+
+PackSyncState::State PackSyncState::Read(const std::filesystem::path& jsonPath)
+{
+    State state;
+    std::ifstream file(PathFor(jsonPath));
+    if (!file.is_open()) return state;
+
+    const auto root = nlohmann::json::parse(file, nullptr, false);
+    if (root.is_discarded() || !root.is_object()) {
+        LOG("SuiteSpot: Ignoring unreadable pack sync state");
+        return state;
+    }
+
+    state.format = root.value("format", 0);
+    state.source = root.value("source", std::string());
+    state.lastSync = static_cast<std::time_t>(root.value("lastSync", int64_t{0}));
+    state.lastFullSync = static_cast<std::time_t>(root.value("lastFullSync", int64_t{0}));
+    return state;
+}
+
+bool PackSyncState::Write(const std::filesystem::path& jsonPath, const State& state)
+{
+    try {
+        nlohmann::json root;
+        root["format"] = state.format;
+        root["source"] = state.source;
+        root["lastSync"] = static_cast<int64_t>(state.lastSync);
+        root["lastFullSync"] = static_cast<int64_t>(state.lastFullSync);
+
+        const auto syncPath = PathFor(jsonPath);
+        auto tempPath = syncPath;
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::trunc);
+            if (!file.is_open()) {
+                LOG("SuiteSpot: Failed to write pack sync state: {}", tempPath.string());
+                return false;
+            }
+            file << root.dump(2);
+        }
+        std::filesystem::rename(tempPath, syncPath);
+        return true;
+
+    } catch (const std::exception& e) {
+        LOG("SuiteSpot: Error writing pack sync state: {}", std::string(e.what()));
+        return false;
+    }
+}
+
+std::string PackSyncState::HttpDate(std::time_t time)
+{
+    // HTTP dates use English day/month names whatever the user's locale is
+    std::ostringstream oss;
+    oss.imbue(std::locale::classic());
+    oss << std::put_time(std::gmtime(&time), "%a, %d %b %Y %H:%M:%S GMT");
+    return oss.str();
+}
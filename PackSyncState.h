@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <string>
+
+/*
+ * ======================================================================================
+ * PACK SYNC STATE: WHEN AND HOW THE PACK LIST WAS LAST DOWNLOADED
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * A small file next to `training_packs.json` (`training_packs.sync.json`) remembering the
+ * last time the updater ran, the last time it downloaded everything, where from, and
+ * which file layout it wrote.
+ *
+ * WHY IS IT HERE?
+ * An update normally only needs the newest packs: the updater walks the list newest-first
+ * and stops once it's back among packs it already has. That's only safe if the pack file
+ * came from a complete download from the same source in the current layout. This file is
+ * how the manager knows, and decides between a quick sync and a full one.
+ *
+ * HOW DOES IT WORK?
+ * 1. Written after every successful update (full or quick) through a temp file + rename.
+ * 2. `NeedsFullSync()` is true when there's no state, it was written by an older layout
+ *    (`kFormat`), or the source URL changed. The user can also ask for a full sync.
+ * 3. `lastSync` doubles as the `If-Modified-Since` date for the quick sync's first request.
+ */
+
+namespace PackSyncState
+{
+    // Bump when training_packs.json's layout or the scraper's field rules change;
+    // existing pack files then get one full download
+    constexpr int kFormat = 1;
+
+    struct State
+    {
+        int format = 0;                // 0 = no state file
+        std::string source;            // Source URL the pack file came from
+        std::time_t lastSync = 0;      // Last successful update of either kind (UTC)
+        std::time_t lastFullSync = 0;  // Last complete download (UTC)
+
+        bool NeedsFullSync(const std::string& currentSource) const
+        {
+            return format != kFormat || lastFullSync == 0 || source != currentSource;
+        }
+    };
+
+    // training_packs.json -> training_packs.sync.json
+    std::filesystem::path PathFor(const std::filesystem::path& jsonPath);
+
+    // Missing or unreadable file = default State (forces a full sync)
+    State Read(const std::filesystem::path& jsonPath);
+    bool Write(const std::filesystem::path& jsonPath, const State& state);
+
+    // "Wed, 21 Oct 2015 07:28:00 GMT", for If-Modified-Since
+    std::string HttpDate(std::time_t time);
+}
@@ -5,116 +5,388 @@
 #include <fstream>
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <utility>
 
 using json = nlohmann::json;
 
+namespace
+{
+    int64_t NowSeconds()
+    {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count();
+    }
+
+    constexpr double kSecondsPerDay = 86400.0;
+
+    // log2(2^a + 2^b) without overflowing
+    double LogAdd2(double a, double b)
+    {
+        const double hi = std::max(a, b);
+        return hi + std::log2(1.0 + std::exp2(std::min(a, b) - hi));
+    }
+}
+
 PackUsageTracker::PackUsageTracker(const std::filesystem::path& statsFilePath)
     : filePath(statsFilePath)
 {
+    logPath = filePath;
+    logPath.replace_extension(".events.jsonl");
     LoadStats();
+    flushThread = std::thread([this]() { FlushLoop(); });
+}
+
+PackUsageTracker::~PackUsageTracker()
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopFlusher = true;
+    }
+    wake.notify_one();
+    if (flushThread.joinable()) {
+        flushThread.join();
+    }
+    SaveStats();
 }
 
 void PackUsageTracker::LoadStats()
 {
+    std::lock_guard<std::mutex> io(ioMutex);
     std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (!std::filesystem::exists(filePath)) {
-        isFirstRun = true;
+
+    // Snapshot + log is the whole history, so start from nothing
+    stats.clear();
+    ranking.clear();
+    snapshotSeq = 0;
+    if (std::filesystem::exists(filePath)) {
+        try {
+            std::ifstream file(filePath);
+            if (file.is_open()) {
+                json j;
+                file >> j;
+
+                snapshotSeq = j.value("lastSeq", uint64_t{0});
+                // Scores are only meaningful with the half-life they were built with
+                halfLifeDays = j.value("halfLifeDays", halfLifeDays);
+                bool hasFrecency = j.contains("halfLifeDays");
+                if (j.contains("stats") && j["stats"].is_array()) {
+                    for (const auto& item : j["stats"]) {
+                        PackUsageStats s;
+                        s.loadCount = item.value("loadCount", 0);
+                        s.lastLoadedTimestamp = item.value("lastLoadedTimestamp", 0LL);
+                        s.frecency = item.value("frecency", 0.0);
+                        hasFrecency = hasFrecency && item.contains("frecency");
+
+                        if (PackCode::Parse(item.value("code", ""), s.code)) {
+                            // Older files could list one pack under two spellings; merge them
+                            auto [it, first] = stats.try_emplace(s.code);
+                            auto& merged = it->second;
+                            merged.code = s.code;
+                            merged.loadCount += s.loadCount;
+                            merged.lastLoadedTimestamp = std::max(merged.lastLoadedTimestamp, s.lastLoadedTimestamp);
+                            merged.frecency = first ? s.frecency : LogAdd2(merged.frecency, s.frecency);
+                        }
+                    }
+                }
+                if (!hasFrecency) {
+                    Reseed();  // Written before frecency existed
+                }
+            }
+        }
+        catch (const std::exception& e) {
+            LOG("Failed to load pack usage stats: {}", e.what());
+        }
+    }
+
+    // Loads logged after the snapshot was written
+    nextSeq = snapshotSeq + 1;
+    eventsInLog = 0;
+    std::ifstream log(logPath);
+    std::string line;
+    while (log.is_open() && std::getline(log, line)) {
+        const auto event = json::parse(line, nullptr, false);
+        if (event.is_discarded() || !event.is_object()) continue;  // Cut off by a crash
+
+        const uint64_t seq = event.value("seq", uint64_t{0});
+        PackCode code;
+        if (seq <= snapshotSeq || !PackCode::Parse(event.value("code", ""), code)) continue;
+
+        RecordLoad(code, event.value("t", int64_t{0}));
+        nextSeq = std::max(nextSeq, seq + 1);
+        ++eventsInLog;
+    }
+
+    RebuildRanking();
+    isFirstRun = stats.empty();
+    ++version;
+}
+
+void PackUsageTracker::SaveStats()
+{
+    std::lock_guard<std::mutex> io(ioMutex);
+    DrainEvents();
+    WriteSnapshot();
+}
+
+void PackUsageTracker::IncrementLoadCount(const std::string& packCode)
+{
+    PackCode code;
+    if (!PackCode::Parse(packCode, code)) {
+        LOG("SuiteSpot: Not counting load of invalid pack code: {}", packCode);
         return;
     }
 
+    auto* event = new LoadEvent{ code, NowSeconds(), pendingEvents.load(std::memory_order_relaxed) };
+    while (!pendingEvents.compare_exchange_weak(event->next, event,
+                                                std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    // Not under wakeMutex (that would be a lock); a missed wakeup waits for the flusher's timeout
+    wake.notify_one();
+}
+
+void PackUsageTracker::FlushLoop()
+{
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    while (!stopFlusher) {
+        wake.wait_for(lock, std::chrono::seconds(1),
+            [this]() { return stopFlusher || pendingEvents.load(std::memory_order_relaxed) != nullptr; });
+        if (stopFlusher) break;
+        if (pendingEvents.load(std::memory_order_relaxed) == nullptr) continue;
+
+        // Let loads made close together go out as one write
+        wake.wait_for(lock, kBatchWindow, [this]() { return stopFlusher; });
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> io(ioMutex);
+            DrainEvents();
+            if (eventsInLog >= kCompactAfter) {
+                WriteSnapshot();
+            }
+        }
+        lock.lock();
+    }
+    // The destructor's SaveStats() writes whatever is left
+}
+
+void PackUsageTracker::DrainEvents()
+{
+    LoadEvent* head = pendingEvents.exchange(nullptr, std::memory_order_acquire);
+    if (!head) return;
+
+    // The list is newest first; count and log in the order the loads happened
+    std::vector<LoadEvent> batch;
+    while (head) {
+        batch.push_back(*head);
+        delete std::exchange(head, head->next);
+    }
+    std::reverse(batch.begin(), batch.end());
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& event : batch) {
+            RecordLoad(event.code, event.timestamp);
+        }
+        RefreshTopCodes();
+    }
+    isFirstRun = false;
+    ++version;
+
     try {
-        std::ifstream file(filePath);
-        if (!file.is_open()) return;
+        std::filesystem::create_directories(logPath.parent_path());
 
-        json j;
-        file >> j;
-
-        if (j.contains("stats") && j["stats"].is_array()) {
-            for (const auto& item : j["stats"]) {
-                PackUsageStats s;
-                s.code = item.value("code", "");
-                s.loadCount = item.value("loadCount", 0);
-                s.lastLoadedTimestamp = item.value("lastLoadedTimestamp", 0LL);
-                
-                if (!s.code.empty()) {
-                    stats[s.code] = s;
-                }
+        // A write cut off mid-line (crash, full disk) would swallow the next line too; end it first
+        bool needsNewline = false;
+        {
+            std::ifstream existing(logPath, std::ios::binary | std::ios::ate);
+            if (existing.is_open() && existing.tellg() > 0) {
+                existing.seekg(-1, std::ios::end);
+                needsNewline = existing.get() != '\n';
             }
-            isFirstRun = stats.empty();
         }
+
+        std::string lines;
+        if (needsNewline) {
+            lines += '\n';
+        }
+        for (const auto& event : batch) {
+            lines += json{ {"seq", nextSeq++}, {"code", event.code.ToString()}, {"t", event.timestamp} }.dump();
+            lines += '\n';
+        }
+
+        // One write and one FlushFileBuffers per batch: the lines are on disk, not just in
+        // the OS cache, before the flusher goes back to sleep
+        HANDLE handle = CreateFileW(logPath.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ, nullptr,
+                                    OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (handle == INVALID_HANDLE_VALUE) {
+            LOG("SuiteSpot: Failed to append to pack usage log: {}", logPath.string());
+            return;  // Still counted in memory; the next snapshot saves it
+        }
+        DWORD written = 0;
+        const bool synced = WriteFile(handle, lines.data(), static_cast<DWORD>(lines.size()), &written, nullptr) &&
+                            written == lines.size() && FlushFileBuffers(handle);
+        CloseHandle(handle);
+        if (!synced) {
+            LOG("SuiteSpot: Failed to write pack usage log: {}", logPath.string());
+            return;
+        }
+        eventsInLog += static_cast<int>(batch.size());
     }
     catch (const std::exception& e) {
-        LOG("Failed to load pack usage stats: {}", e.what());
+        LOG("SuiteSpot: Error writing pack usage log: {}", std::string(e.what()));
     }
 }
 
-void PackUsageTracker::SaveStats() const
+void PackUsageTracker::WriteSnapshot()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
     try {
         json j;
-        j["version"] = "1.0.0";
+        j["version"] = "1.1.0";
+        j["lastSeq"] = nextSeq - 1;
         j["stats"] = json::array();
-        
-        for (const auto& [code, s] : stats) {
-            j["stats"].push_back({
-                {"code", s.code},
-                {"loadCount", s.loadCount},
-                {"lastLoadedTimestamp", s.lastLoadedTimestamp}
-            });
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            j["halfLifeDays"] = halfLifeDays;
+            for (const auto& [code, s] : stats) {
+                j["stats"].push_back({
+                    {"code", s.code.ToString()},
+                    {"loadCount", s.loadCount},
+                    {"lastLoadedTimestamp", s.lastLoadedTimestamp},
+                    {"frecency", s.frecency}
+                });
+            }
         }
 
         std::filesystem::create_directories(filePath.parent_path());
-        std::ofstream file(filePath);
-        if (file.is_open()) {
+        auto tempPath = filePath;
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath);
+            if (!file.is_open()) {
+                LOG("SuiteSpot: Failed to write pack usage stats: {}", tempPath.string());
+                return;
+            }
             file << j.dump(4);
         }
+        std::filesystem::rename(tempPath, filePath);
+        snapshotSeq = nextSeq - 1;
+
+        // Everything in the log is in the snapshot now (lastSeq guards a crash right here)
+        std::ofstream truncate(logPath, std::ios::binary | std::ios::trunc);
+        eventsInLog = 0;
     }
     catch (const std::exception& e) {
         LOG("Failed to save pack usage stats: {}", e.what());
     }
 }
 
-void PackUsageTracker::IncrementLoadCount(const std::string& packCode)
+void PackUsageTracker::RecordLoad(const PackCode& code, int64_t timestamp)
 {
-    if (packCode.empty()) return;
+    auto& s = stats[code];
+    if (s.loadCount > 0) {
+        ranking.erase(KeyFor(s));
+    }
+    s.code = code;
+    if (halfLifeDays > 0) {
+        s.frecency = (s.loadCount == 0) ? ScoreAt(timestamp) : LogAdd2(s.frecency, ScoreAt(timestamp));
+    }
+    s.loadCount++;
+    s.lastLoadedTimestamp = std::max(s.lastLoadedTimestamp, timestamp);
+    ranking.insert(KeyFor(s));
+}
 
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto& s = stats[packCode];
-        s.code = packCode;
-        s.loadCount++;
-        s.lastLoadedTimestamp = std::chrono::duration_cast<std::chrono::seconds>(
-            std::chrono::system_clock::now().time_since_epoch()
-        ).count();
-        isFirstRun = false;
+PackUsageTracker::RankKey PackUsageTracker::KeyFor(const PackUsageStats& s) const
+{
+    return { halfLifeDays > 0 ? s.frecency : static_cast<double>(s.loadCount), s.lastLoadedTimestamp, s.code };
+}
+
+double PackUsageTracker::ScoreAt(int64_t timestamp) const
+{
+    return static_cast<double>(timestamp) / (halfLifeDays * kSecondsPerDay);
+}
+
+void PackUsageTracker::Reseed()
+{
+    // Only the count and the last load are known, so count every load at the last one
+    for (auto& [code, s] : stats) {
+        s.frecency = (halfLifeDays > 0 && s.loadCount > 0)
+            ? ScoreAt(s.lastLoadedTimestamp) + std::log2(static_cast<double>(s.loadCount))
+            : 0.0;
     }
-    
-    SaveStats();
 }
 
-std::vector<std::string> PackUsageTracker::GetTopUsedCodes(int count) const
+void PackUsageTracker::RebuildRanking()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    std::vector<PackUsageStats> allStats;
+    ranking.clear();
     for (const auto& [code, s] : stats) {
-        allStats.push_back(s);
+        ranking.insert(KeyFor(s));
     }
+    RefreshTopCodes();
+}
 
-    // Sort by load count (desc), then by last loaded timestamp (desc)
-    std::sort(allStats.begin(), allStats.end(), [](const PackUsageStats& a, const PackUsageStats& b) {
-        if (a.loadCount != b.loadCount) {
-            return a.loadCount > b.loadCount;
-        }
-        return a.lastLoadedTimestamp > b.lastLoadedTimestamp;
-    });
+void PackUsageTracker::SetHalfLifeDays(int days)
+{
+    days = std::max(days, 0);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (days == halfLifeDays) return;
+
+    LOG("SuiteSpot: Favorites half-life set to {} day(s)", days);
+    halfLifeDays = days;
+    Reseed();
+    RebuildRanking();
+    ++version;
+}
+
+PackUsageStats PackUsageTracker::GetStats(const std::string& packCode) const
+{
+    PackCode code;
+    if (!PackCode::Parse(packCode, code)) return {};
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = stats.find(code);
+    return it != stats.end() ? it->second : PackUsageStats{};
+}
+
+double PackUsageTracker::GetFrecency(const std::string& packCode) const
+{
+    PackCode code;
+    if (!PackCode::Parse(packCode, code)) return 0.0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = stats.find(code);
+    if (it == stats.end()) return 0.0;
+    if (halfLifeDays <= 0) return it->second.loadCount;
+    return std::exp2(it->second.frecency - ScoreAt(NowSeconds()));
+}
+
+void PackUsageTracker::RefreshTopCodes()
+{
+    std::vector<std::string> top;
+    top.reserve(kRankedCount);
+    for (auto it = ranking.begin(); it != ranking.end() && static_cast<int>(top.size()) < kRankedCount; ++it) {
+        top.push_back(it->code.ToString());
+    }
+    if (top != topCodes) {
+        topCodes.swap(top);
+        ++rankingVersion;
+    }
+}
+
+std::vector<std::string> PackUsageTracker::GetTopUsedCodes(int count) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Best score first, ties to the most recent; the top kRankedCount are ready-made
+    if (count <= static_cast<int>(topCodes.size()) || topCodes.size() == ranking.size()) {
+        const size_t n = std::min(static_cast<size_t>(std::max(count, 0)), topCodes.size());
+        return std::vector<std::string>(topCodes.begin(), topCodes.begin() + n);
+    }
 
     std::vector<std::string> result;
-    for (int i = 0; i < std::min(count, (int)allStats.size()); ++i) {
-        result.push_back(allStats[i].code);
+    for (auto it = ranking.begin(); it != ranking.end() && static_cast<int>(result.size()) < count; ++it) {
+        result.push_back(it->code.ToString());
     }
     return result;
 }
@@ -2,29 +2,134 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
 #include <filesystem>
 #include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <thread>
+#include "PackCode.h"
+
+/*
+ * ======================================================================================
+ * PACK USAGE TRACKER: HOW OFTEN EACH PACK GETS LOADED
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * Counts pack loads (and remembers the last one) for "Your Favorites" and the
+ * post-match quick picks.
+ *
+ * WHY IS IT HERE / HOW DOES IT WORK?
+ * Loads are recorded from the match-end hook and from the UI, so recording one must not
+ * touch the disk. `IncrementLoadCount()` only pushes an event onto a lock-free list.
+ * 1. A background thread picks the events up (after a short pause to batch them), adds
+ *    them to the in-memory counts, and appends them as JSONL lines to an event log next
+ *    to the stats file (`pack_usage_stats.events.jsonl`) with one `FlushFileBuffers` per
+ *    batch, so a recorded load survives a crash of the game or the machine.
+ * 2. Every `kCompactAfter` events (and in `SaveStats()`, on unload) the counts are written
+ *    to `pack_usage_stats.json` as one snapshot and the log is emptied.
+ * 3. Events carry a sequence number and the snapshot records the last one it includes, so
+ *    a crash between writing the snapshot and emptying the log can't count a load twice.
+ *    Loading reads the snapshot, then replays the newer log lines.
+ * 4. "Favorites" rank by frecency: every load is worth 1 when it happens and half as much
+ *    after each half-life (`suitespot_favorites_half_life_days`; 0 = lifetime load count).
+ *    Rather than decaying every score as time passes, a pack stores
+ *    frecency = log2(sum of 2^(loadTime / halfLife)). Every pack decays at the same rate,
+ *    so this orders packs exactly like their scores today, a load adds to it in O(1)
+ *    (log-add), and nothing ever needs rescoring. `GetFrecency()` turns it back into
+ *    "loads' worth as of now". Changing the half-life reseeds the scores from the counts
+ *    and last-load times (the per-load history isn't kept).
+ * 5. The ranking (best score first, then most recent) is kept sorted as loads come in: each
+ *    one moves a single entry in an ordered set, O(log n). The first `kRankedCount` codes
+ *    are kept ready as a list, with their own version that only goes up when that list
+ *    actually changes, so the quick picks re-resolve only when the favorites do.
+ */
 
 struct PackUsageStats {
-    std::string code;
+    PackCode code;
     int loadCount = 0;
     int64_t lastLoadedTimestamp = 0;
+    double frecency = 0.0;  // log2 of the decayed load count, measured at time 0 (see below)
 };
 
 class PackUsageTracker {
 public:
     explicit PackUsageTracker(const std::filesystem::path& statsFilePath);
-    
+    ~PackUsageTracker();  // Stops the flusher and writes a final snapshot
+
     void LoadStats();
-    void SaveStats() const;
-    void IncrementLoadCount(const std::string& packCode);
+    void SaveStats();  // Writes queued events and a fresh snapshot now (call on unload)
+    void IncrementLoadCount(const std::string& packCode);  // Lock-free, no file I/O
     std::vector<std::string> GetTopUsedCodes(int count) const;
     bool IsFirstRun() const { return isFirstRun; }
+    uint64_t GetVersion() const { return version; }  // Goes up whenever the stats change
+    uint64_t GetRankingVersion() const { return rankingVersion; }  // Only when the top kRankedCount change
+
+    // Decayed load count as of now (the raw count when the half-life is 0); 0 for unknown codes
+    double GetFrecency(const std::string& packCode) const;
+    PackUsageStats GetStats(const std::string& packCode) const;  // Zeroed for unknown codes
+    void SetHalfLifeDays(int days);  // 0 = rank by lifetime load count; reorders the ranking
+
+    static constexpr int kRankedCount = 15;  // Largest quick picks count
 
 private:
+    struct LoadEvent {
+        PackCode code;
+        int64_t timestamp = 0;
+        LoadEvent* next = nullptr;
+    };
+
+    // Ranking order: best score, then most recently loaded, then code (so keys are unique)
+    struct RankKey {
+        double score = 0.0;  // frecency, or loadCount with no half-life
+        int64_t lastLoadedTimestamp = 0;
+        PackCode code;
+
+        bool operator<(const RankKey& other) const
+        {
+            if (score != other.score) return score > other.score;
+            if (lastLoadedTimestamp != other.lastLoadedTimestamp) return lastLoadedTimestamp > other.lastLoadedTimestamp;
+            return code < other.code;
+        }
+    };
+
+    static constexpr int kDefaultHalfLifeDays = 14;
+    static constexpr std::chrono::milliseconds kBatchWindow{500};  // Gathers loads made together
+    static constexpr int kCompactAfter = 256;                       // Log lines before a snapshot
+
+    void FlushLoop();
+    void DrainEvents();    // Queue -> counts + log; caller holds ioMutex
+    void WriteSnapshot();  // Counts -> stats file, then empties the log; caller holds ioMutex
+    void RecordLoad(const PackCode& code, int64_t timestamp);  // Counts + ranking; caller holds mutex_
+    void RefreshTopCodes();                                     // Caller holds mutex_
+    RankKey KeyFor(const PackUsageStats& s) const;              // Caller holds mutex_
+    double ScoreAt(int64_t timestamp) const;                    // timestamp / halfLife; caller holds mutex_
+    void Reseed();          // Frecency from counts + last loads; caller holds mutex_
+    void RebuildRanking();  // Caller holds mutex_
+
     std::filesystem::path filePath;
-    std::map<std::string, PackUsageStats> stats;
-    bool isFirstRun = true;
-    mutable std::mutex mutex_;
+    std::filesystem::path logPath;
+    std::map<PackCode, PackUsageStats> stats;  // Any spelling of a code counts as the same pack
+    std::set<RankKey> ranking;                 // One key per entry in stats
+    std::vector<std::string> topCodes;         // First kRankedCount of ranking
+    std::atomic<bool> isFirstRun{true};
+    mutable std::mutex mutex_;  // Protects stats, ranking, topCodes
+    std::atomic<uint64_t> version{0};
+    std::atomic<uint64_t> rankingVersion{0};
+    int halfLifeDays = kDefaultHalfLifeDays;  // mutex_; the stored frecency values use this one
+
+    // Events recorded but not yet counted, newest first (a Treiber stack)
+    std::atomic<LoadEvent*> pendingEvents{nullptr};
+
+    std::mutex ioMutex;          // One writer of the log/snapshot at a time; protects below
+    uint64_t nextSeq = 1;        // Sequence number of the next logged event
+    uint64_t snapshotSeq = 0;    // Last sequence number the snapshot includes
+    int eventsInLog = 0;
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    bool stopFlusher = false;    // wakeMutex
+    std::thread flushThread;
 };
@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "SettingsSync.h"
+#include "PackScraper.h"
 
 #include <algorithm>
 
@@ -10,71 +11,97 @@ void SettingsSync::RegisterAllCVars(const std::shared_ptr<CVarManagerWrapper>& c
     cvarManager->registerCvar("suitespot_enabled", "0", "Enable SuiteSpot", true, true, 0, true, 1)
         .addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
             enabled = cvar.getBoolValue();
+            ++version;
         });
 
     cvarManager->registerCvar("suitespot_map_type", "0", "Map type: 0=Freeplay, 1=Training, 2=Workshop", true, true, 0, true, 2)
         .addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
             mapType = cvar.getIntValue();
+            ++version;
         });
 
     cvarManager->registerCvar("suitespot_auto_queue", "0", "Enable auto-queuing after map load", true, true, 0, true, 1)
         .addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
             autoQueue = cvar.getBoolValue();
+            ++version;
         });
 
     cvarManager->registerCvar("suitespot_quickpicks_list_type", "0", "List type: 0=Flicks Picks, 1=Your Favorites", true, true, 0, true, 1)
         .addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
             quickPicksListType = cvar.getIntValue();
+            ++version;
         });
 
     cvarManager->registerCvar("suitespot_quickpicks_count", "10", "Number of quick picks to show", true, true, 5, true, 15)
         .addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
             quickPicksCount = cvar.getIntValue();
+            ++version;
         });
 
     cvarManager->registerCvar("suitespot_quickpicks_selected", "", "Selected quick pick pack code", true)
         .addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
             quickPicksSelected = cvar.getStringValue();
+            ++version;
         });
 
     cvarManager->registerCvar("suitespot_delay_queue_sec", "0", "Delay before queuing (seconds)", true, true, 0, true, 300)
         .addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
             delayQueueSec = std::max(0, cvar.getIntValue());
+            ++version;
         });
 
     cvarManager->registerCvar("suitespot_delay_freeplay_sec", "0", "Delay before loading freeplay map (seconds)", true, true, 0, true, 300)
         .addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
             delayFreeplaySec = std::max(0, cvar.getIntValue());
+            ++version;
         });
 
     cvarManager->registerCvar("suitespot_delay_training_sec", "0", "Delay before loading training map (seconds)", true, true, 0, true, 300)
         .addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
             delayTrainingSec = std::max(0, cvar.getIntValue());
+            ++version;
         });
 
     cvarManager->registerCvar("suitespot_delay_workshop_sec", "0", "Delay before loading workshop map (seconds)", true, true, 0, true, 300)
         .addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
             delayWorkshopSec = std::max(0, cvar.getIntValue());
+            ++version;
         });
 
     cvarManager->registerCvar("suitespot_current_freeplay_code", "", "Currently selected freeplay map code", true)
         .addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
             currentFreeplayCode = cvar.getStringValue();
+            ++version;
         });
 
     cvarManager->registerCvar("suitespot_current_training_code", "", "Currently selected training pack code", true)
         .addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
             currentTrainingCode = cvar.getStringValue();
+            ++version;
         });
 
     cvarManager->registerCvar("suitespot_current_workshop_path", "", "Currently selected workshop map path", true)
         .addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
             currentWorkshopPath = cvar.getStringValue();
+            ++version;
         });
 
     cvarManager->registerCvar("suitespot_auto_download_textures", "0", "Auto-download missing workshop textures on launch", true, true, 0, true, 1)
         .addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
             autoDownloadTextures = cvar.getBoolValue();
+            ++version;
+        });
+
+    cvarManager->registerCvar("suitespot_favorites_half_life_days", "14", "Days for a pack load to count half as much in Your Favorites (0 = lifetime load count)", true, true, 0, true, 365)
+        .addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
+            favoritesHalfLifeDays = cvar.getIntValue();
+            ++version;
+        });
+
+    cvarManager->registerCvar("suitespot_pack_source_url", PackScraper::kDefaultSourceUrl, "Training pack list the updater downloads (paged with ?page=N)", true)
+        .addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
+            packSourceUrl = cvar.getStringValue();
+            ++version;
         });
 
     cvarManager->registerCvar("ss_training_maps", "", "Stored training maps", true, false, 0, false, 0);
@@ -87,19 +114,23 @@ void SettingsSync::RegisterAllCVars(const std::shared_ptr<CVarManagerWrapper>& c
 void SettingsSync::SetCurrentFreeplayCode(const std::string& code)
 {
     currentFreeplayCode = code;
+    ++version;
 }
 
 void SettingsSync::SetCurrentTrainingCode(const std::string& code)
 {
     currentTrainingCode = code;
+    ++version;
 }
 
 void SettingsSync::SetQuickPicksSelected(const std::string& code)
 {
     quickPicksSelected = code;
+    ++version;
 }
 
 void SettingsSync::SetCurrentWorkshopPath(const std::string& path)
 {
     currentWorkshopPath = path;
+    ++version;
 }
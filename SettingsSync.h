@@ -1,5 +1,7 @@
 #pragma once
 #include "bakkesmod/plugin/bakkesmodplugin.h"
+#include <atomic>
+#include <cstdint>
 #include <memory>
 
 /*
@@ -37,6 +39,7 @@ public:
     // Bag rotation removed - GetTrainingMode() removed
     int GetQuickPicksListType() const { return quickPicksListType; }
     int GetQuickPicksCount() const { return quickPicksCount; }
+    int GetFavoritesHalfLifeDays() const { return favoritesHalfLifeDays; }  // 0 = lifetime counts
     std::string GetQuickPicksSelected() const { return quickPicksSelected; }
 
     // Delay getters (How long to wait?)
@@ -48,12 +51,18 @@ public:
     // Texture settings
     bool IsAutoDownloadTextures() const { return autoDownloadTextures; }
 
+    // Pack updater source (empty until the cvar loads; the manager falls back to the default)
+    std::string GetPackSourceUrl() const { return packSourceUrl; }
+
     // Selection getters (Which map/pack is selected?)
     std::string GetCurrentFreeplayCode() const { return currentFreeplayCode; }
     std::string GetCurrentTrainingCode() const { return currentTrainingCode; }
     std::string GetQuickPicksSelectedCode() const { return quickPicksSelected; }
     std::string GetCurrentWorkshopPath() const { return currentWorkshopPath; }
 
+    // Goes up whenever any setting above changes; UI caches compare it instead of every value
+    uint64_t GetVersion() const { return version; }
+
     // Setters: Update the local value (used when loading data)
     void SetCurrentFreeplayCode(const std::string& code);
     void SetCurrentTrainingCode(const std::string& code);
@@ -62,6 +71,8 @@ public:
     void SetTrainingMode(int mode);
 
 private:
+    std::atomic<uint64_t> version{0};
+
     // Local copies of settings for fast access
     bool enabled = false;
     int mapType = 0; // 0=Freeplay, 1=Training, 2=Workshop
@@ -70,6 +81,7 @@ private:
     // Bag rotation removed - trainingMode variable removed
     int quickPicksListType = 0; // 0=Flicks Picks, 1=Your Favorites
     int quickPicksCount = 10;
+    int favoritesHalfLifeDays = 14;
     std::string quickPicksSelected = "";
 
     int delayQueueSec = 0;
@@ -78,6 +90,7 @@ private:
     int delayWorkshopSec = 0;
 
     bool autoDownloadTextures = false;
+    std::string packSourceUrl;
 
     std::string currentFreeplayCode;   // Freeplay map code (e.g., "beckwith_park_p")
     std::string currentTrainingCode;   // Training pack code (e.g., "XXXX-XXXX-XXXX-XXXX")
@@ -114,15 +114,11 @@ void SettingsUI::RenderMainSettingsWindow() {
         } else if (mapTypeValue == 1) {
             mapDelayStr = std::to_string(delayTrainingSecValue) + "s";
 
-            // Get packs from manager for consistent lookup
-            const auto& trainingPacks = plugin_->trainingPackMgr ?
-                plugin_->trainingPackMgr->GetPacks() : RLTraining;
-
             // Bag rotation removed - show single pack mode
             std::string targetCode = quickPicksSelectedCode;
             if (targetCode.empty()) targetCode = currentTrainingCode;
             
-            const TrainingEntry* targetPack = plugin_->trainingPackMgr->GetPackByCode(targetCode);
+            const PackRef targetPack = plugin_->trainingPackMgr->FindPack(targetCode);
             if (targetPack) {
                 currentMap = targetPack->name;
             } else if (!targetCode.empty()) {
@@ -377,21 +373,103 @@ void SettingsUI::RenderTrainingMode(int trainingModeValue, std::string& currentT
     if (ImGui::IsItemHovered()) {
         ImGui::SetTooltip("Open the full training pack browser to manage bags and packs");
     }
+
+    RenderPackUpdateStatus();
+}
+
+void SettingsUI::RenderPackUpdateStatus() {
+    if (!plugin_->trainingPackMgr) return;
+    const PackUpdateStatus update = plugin_->trainingPackMgr->GetUpdateStatus();
+    const PackScraper::Progress& progress = update.progress;
+
+    switch (update.state) {
+        case PackUpdateState::Idle:
+            return;
+        case PackUpdateState::Fetching:
+        case PackUpdateState::Merging:
+            break;
+        case PackUpdateState::Done:
+            ImGui::Spacing();
+            ImGui::TextDisabled("Pack list updated (%d page(s), %.1fs)", progress.pagesDone, progress.elapsedSeconds);
+            return;
+        case PackUpdateState::Failed:
+            ImGui::Spacing();
+            // Failed pages are only one way to fail (also: nothing scraped, write or merge failed)
+            if (progress.failedPages > 0) {
+                ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "Pack update failed (%d page(s) could not be fetched) - list unchanged",
+                    progress.failedPages);
+            } else {
+                ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "Pack update failed - list unchanged");
+            }
+            return;
+        case PackUpdateState::Cancelled:
+            ImGui::Spacing();
+            ImGui::TextDisabled("Pack update cancelled - list unchanged");
+            return;
+    }
+
+    ImGui::Spacing();
+    ImGui::Separator();
+    if (update.state == PackUpdateState::Merging) {
+        ImGui::TextColored(UI::TrainingPackUI::SCRAPING_STATUS_TEXT_COLOR, "Merging %d packs...", progress.packsParsed);
+        return;
+    }
+
+    // A quick sync stops at known packs, so its page total is only an upper bound
+    if (progress.pagesTotal > 0 && !progress.quickSync) {
+        const float fraction = static_cast<float>(progress.pagesDone) / static_cast<float>(progress.pagesTotal);
+        const std::string overlay = std::to_string(progress.pagesDone) + " / " + std::to_string(progress.pagesTotal) + " pages";
+        ImGui::ProgressBar(fraction, ImVec2(300, 20), overlay.c_str());
+    } else {
+        ImGui::TextColored(UI::TrainingPackUI::SCRAPING_STATUS_TEXT_COLOR,
+            progress.quickSync ? "Checking for new packs... %d page(s)" : "Updating pack list... %d page(s)", progress.pagesDone);
+    }
+
+    ImGui::Text("%d packs | %.1f MB | %.1f pages/s", progress.packsParsed,
+        progress.bytesFetched / (1024.0 * 1024.0), progress.PagesPerSecond());
+    const double eta = progress.EtaSeconds();
+    if (eta >= 0.0 && !progress.quickSync) {
+        ImGui::SameLine();
+        ImGui::Text("| ETA %ds", static_cast<int>(eta + 0.5));
+    }
+    if (progress.retries > 0 || progress.failedPages > 0) {
+        ImGui::TextColored(ImVec4(1.0f, 0.7f, 0.4f, 1.0f), "%d retried, %d failed", progress.retries, progress.failedPages);
+    }
+
+    if (ImGui::Button("Cancel Update", ImVec2(140, 25))) {
+        plugin_->trainingPackMgr->CancelUpdate();
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Stop after the requests already sent; the current pack list is kept");
+    }
 }
 
 void SettingsUI::RenderWorkshopMode(std::string& currentWorkshopPath) {
     // Header with Refresh button
     ImGui::TextColored(UI::TrainingPackUI::SECTION_HEADER_TEXT_COLOR, "Local Workshop Maps");
     ImGui::SameLine(ImGui::GetContentRegionAvail().x - 70.0f);
-    if (ImGui::Button("Refresh", ImVec2(70, 0))) {
+    const bool scanning = (plugin_->GetWorkshopLoadState() == CatalogLoadState::Loading);
+    if (scanning) {
+        ImGui::PushStyleVar(ImGuiStyleVar_Alpha, ImGui::GetStyle().Alpha * 0.5f);
+    }
+    if (ImGui::Button("Refresh", ImVec2(70, 0)) && !scanning) {
         plugin_->LoadWorkshopMaps();
         selectedWorkshopIndex = -1;  // Reset selection
     }
+    if (scanning) {
+        ImGui::PopStyleVar();
+    }
     if (ImGui::IsItemHovered()) {
         ImGui::SetTooltip("Rescan workshop folders for maps");
     }
     ImGui::Spacing();
 
+    // The scan runs in the background; keep showing the previous list until it lands
+    if (scanning && RLWorkshop.empty()) {
+        ImGui::TextDisabled("Scanning workshop folders...");
+        return;
+    }
+
     // Check if we have any maps
     if (RLWorkshop.empty()) {
         ImGui::TextColored(UI::WorkshopBrowserUI::NO_MAPS_COLOR,
@@ -405,14 +483,20 @@ void SettingsUI::RenderWorkshopMode(std::string& currentWorkshopPath) {
         return;
     }
 
-    // Initialize selection from current CVar if needed
-    if (selectedWorkshopIndex < 0 && !currentWorkshopPath.empty()) {
+    // Re-find the saved map's row only when the list or the saved path changes; a rescan
+    // can reorder the list, so the old index would point at a different map
+    const uint64_t workshopVersion = plugin_->GetWorkshopVersion();
+    const uint64_t settingsVersion = plugin_->settingsSync->GetVersion();
+    if (workshopVersion != lastWorkshopVersion || settingsVersion != lastWorkshopSettingsVersion) {
+        selectedWorkshopIndex = -1;
         for (int i = 0; i < (int)RLWorkshop.size(); i++) {
             if (RLWorkshop[i].filePath == currentWorkshopPath) {
                 selectedWorkshopIndex = i;
                 break;
             }
         }
+        lastWorkshopVersion = workshopVersion;
+        lastWorkshopSettingsVersion = settingsVersion;
     }
 
     // Clamp selection to valid range
@@ -603,6 +687,15 @@ if (ImGui::RadioButton("Your Favorites", listType == 1)) {
 if (ImGui::IsItemHovered()) {
     ImGui::SetTooltip("Your most-used training packs based on load history");
 }
+if (listType == 1) {
+    int halfLifeDays = plugin_->settingsSync->GetFavoritesHalfLifeDays();
+    ImGui::SameLine();
+    ImGui::TextUnformatted("Half-life (days):");
+    ImGui::SameLine();
+    UI::Helpers::InputIntWithRange("##FavoritesHalfLife", halfLifeDays, 0, 365, 80.0f,
+        "suitespot_favorites_half_life_days", plugin_->cvarManager, plugin_->gameWrapper,
+        "Recent loads count more: a load counts half as much after this many days.\n0 = rank by lifetime load count.", nullptr);
+}
 
 ImGui::Spacing();
 ImGui::Separator();
@@ -617,46 +710,36 @@ if (listType == 0) {
 ImGui::SameLine();
 ImGui::TextDisabled("(Select post-match pack)");
 
-std::vector<std::string> quickPicks = GetQuickPicksList();
+// Names, shots and descriptions only change with the catalog, the favorites ranking or settings
+const uint64_t catalogVersion = plugin_->trainingPackMgr ? plugin_->trainingPackMgr->GetVersion() : 0;
+const uint64_t usageVersion = plugin_->usageTracker ? plugin_->usageTracker->GetRankingVersion() : 0;
+const uint64_t settingsVersion = plugin_->settingsSync->GetVersion();
+if (!quickPicksInitialized || catalogVersion != quickPicksCatalogVersion ||
+    usageVersion != quickPicksUsageVersion || settingsVersion != quickPicksSettingsVersion) {
+    RebuildQuickPicks();
+    quickPicksCatalogVersion = catalogVersion;
+    quickPicksUsageVersion = usageVersion;
+    quickPicksSettingsVersion = settingsVersion;
+    quickPicksInitialized = true;
+}
+
 std::string selectedCode = plugin_->settingsSync->GetQuickPicksSelectedCode();
     
     // If nothing selected, default to the first one in the list
-    if (selectedCode.empty() && !quickPicks.empty()) {
-        selectedCode = quickPicks[0];
+    if (selectedCode.empty() && !quickPickRows.empty()) {
+        selectedCode = quickPickRows[0].code;
         plugin_->settingsSync->SetQuickPicksSelected(selectedCode);
         plugin_->cvarManager->getCvar("suitespot_quickpicks_selected").setValue(selectedCode);
     }
 
     if (ImGui::BeginChild("QuickPicksList", ImVec2(UI::QuickPicksUI::TABLE_WIDTH, UI::QuickPicksUI::TABLE_HEIGHT), true)) {
-        for (const auto& code : quickPicks) {
-            std::string name = "Unknown Pack";
-            int shots = 0;
-            std::string description = "";
-            bool found = false;
-
-            // 1. Try to find in loaded cache
-            const auto& trainingPacks = plugin_->trainingPackMgr ? plugin_->trainingPackMgr->GetPacks() : RLTraining;
-            auto it = std::find_if(trainingPacks.begin(), trainingPacks.end(), [&](const TrainingEntry& e) { return e.code == code; });
-            
-            if (it != trainingPacks.end()) {
-                name = it->name;
-                shots = it->shotCount;
-                description = it->staffComments.empty() ? it->notes : it->staffComments;
-                found = true;
-            } else {
-                // 2. Try to find in DefaultPacks (Hardcoded fallback for first run)
-                for (const auto& defPack : DefaultPacks::FLICKS_PICKS) {
-                    if (defPack.code == code) {
-                        name = defPack.name;
-                        shots = defPack.shotCount;
-                        description = defPack.description;
-                        found = true;
-                        break;
-                    }
-                }
-            }
+        for (const auto& row : quickPickRows) {
+            const std::string& code = row.code;
+            const std::string& name = row.name;
+            const int shots = row.shots;
+            const std::string& description = row.description;
 
-            if (found) {
+            if (row.found) {
                 bool isSelected = (code == selectedCode);
                 
                 // Add top padding
@@ -736,6 +819,36 @@ std::vector<std::string> SettingsUI::GetQuickPicksList() {
     
     return topCodes;
 }
+
+void SettingsUI::RebuildQuickPicks() {
+    quickPickRows.clear();
+    for (const auto& code : GetQuickPicksList()) {
+        QuickPickRow row;
+        row.code = code;
+
+        // 1. Try to find in loaded cache
+        const PackRef it = plugin_->trainingPackMgr ? plugin_->trainingPackMgr->FindPack(code) : PackRef{};
+
+        if (it) {
+            row.name = it->name;
+            row.shots = it->shotCount;
+            row.description = it->staffComments.empty() ? it->notes : it->staffComments;
+            row.found = true;
+        } else {
+            // 2. Try to find in DefaultPacks (Hardcoded fallback for first run)
+            for (const auto& defPack : DefaultPacks::FLICKS_PICKS) {
+                if (defPack.code == code) {
+                    row.name = defPack.name;
+                    row.shots = defPack.shotCount;
+                    row.description = defPack.description;
+                    row.found = true;
+                    break;
+                }
+            }
+        }
+        quickPickRows.push_back(std::move(row));
+    }
+}
 void SettingsUI::RenderWorkshopBrowserTab() {
     if (!plugin_->workshopDownloader) {
         ImGui::TextDisabled("Workshop downloader not initialized");
@@ -2,6 +2,7 @@
 #include "IMGUI/imgui.h"
 #include "StatusMessageUI.h"
 #include "WorkshopDownloader.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
@@ -46,11 +47,13 @@ private:
     void RenderMapSelectionTab(int mapTypeValue, bool bagRotationEnabledValue, std::string& currentFreeplayCode, std::string& currentTrainingCode, std::string& currentWorkshopPath, int& delayFreeplaySecValue, int& delayTrainingSecValue, int& delayWorkshopSecValue, int& delayQueueSecValue);
     void RenderFreeplayMode(std::string& currentFreeplayCode);
     void RenderTrainingMode(int trainingModeValue, std::string& currentTrainingCode);
+    void RenderPackUpdateStatus();  // Progress + cancel while the pack list updates
     void RenderWorkshopMode(std::string& currentWorkshopPath);
 
     void RenderSinglePackMode(std::string& currentTrainingCode);
     void RenderBagRotationMode();
     std::vector<std::string> GetQuickPicksList();
+    void RebuildQuickPicks();
     
     // Workshop browser tab
     void RenderWorkshopBrowserTab();
@@ -66,6 +69,20 @@ private:
     void CenterNextItem(float itemWidth);
     std::string LimitTextSize(std::string str, float maxTextSize);
 
+    // Quick picks rows, rebuilt only when the catalog, usage stats or settings version changes
+    struct QuickPickRow {
+        std::string code;
+        std::string name;
+        int shots = 0;
+        std::string description;
+        bool found = false;  // In the catalog or the built-in defaults
+    };
+    std::vector<QuickPickRow> quickPickRows;
+    uint64_t quickPicksCatalogVersion = 0;
+    uint64_t quickPicksUsageVersion = 0;
+    uint64_t quickPicksSettingsVersion = 0;
+    bool quickPicksInitialized = false;
+
     // Workshop path configuration state
     char workshopPathBuf[512] = {0};
     bool workshopPathInit = false;
@@ -77,6 +94,8 @@ private:
 
     // Workshop local browser state (two-panel layout)
     int selectedWorkshopIndex = -1;  // Currently selected in list
+    uint64_t lastWorkshopVersion = 0;          // RLWorkshop version the selection was resolved against
+    uint64_t lastWorkshopSettingsVersion = 0;  // Settings version (saved path) likewise
     std::string lastSelectedWorkshopPath;  // Track path to detect changes
     
     // Pending download state for confirmation flow
@@ -0,0 +1,432 @@
+#include "pch.h"
+#include "ShotStats.h"
+#include "logging.h"
+#include "IMGUI/json.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+using json = nlohmann::json;
+
+namespace
+{
+    constexpr int kFormat = 1;
+    constexpr int kMaxRounds = 256;  // Rounds past this are counted in the pack total only
+
+    json AggregateToJson(const ShotAggregate& a)
+    {
+        const auto& buckets = a.timeToGoal.Buckets();
+        int used = DurationHistogram::kBuckets;
+        while (used > 0 && buckets[used - 1] == 0) --used;
+        return json{
+            {"n", a.attempts},
+            {"g", a.goals},
+            {"lead", a.leadingGoals},
+            {"trail", a.trailingGoals},
+            {"best", a.bestStreak},
+            {"t", std::vector<uint32_t>(buckets.begin(), buckets.begin() + used)}
+        };
+    }
+
+    ShotAggregate AggregateFromJson(const json& j)
+    {
+        ShotAggregate a;
+        a.attempts = j.value("n", 0u);
+        a.goals = j.value("g", 0u);
+        a.leadingGoals = j.value("lead", 0u);
+        a.trailingGoals = j.value("trail", 0u);
+        a.bestStreak = j.value("best", 0u);
+        if (j.contains("t") && j["t"].is_array()) {
+            const auto& t = j["t"];
+            for (int i = 0; i < DurationHistogram::kBuckets && i < static_cast<int>(t.size()); ++i) {
+                a.timeToGoal.SetBucket(i, t[i].get<uint32_t>());
+            }
+        }
+        return a;
+    }
+}
+
+// ===== DurationHistogram =====
+
+double DurationHistogram::BucketUpperMs(int bucket)
+{
+    return kFirstBucketMs * std::exp2(bucket / kBucketsPerDoubling);
+}
+
+void DurationHistogram::Add(double ms, uint32_t count)
+{
+    int bucket = 0;
+    if (ms > kFirstBucketMs) {
+        bucket = static_cast<int>(std::ceil(kBucketsPerDoubling * std::log2(ms / kFirstBucketMs)));
+        bucket = std::clamp(bucket, 0, kBuckets - 1);
+    }
+    counts[bucket] += count;
+    total += count;
+}
+
+void DurationHistogram::Merge(const DurationHistogram& other)
+{
+    for (int i = 0; i < kBuckets; ++i) {
+        counts[i] += other.counts[i];
+    }
+    total += other.total;
+}
+
+void DurationHistogram::SetBucket(int bucket, uint32_t count)
+{
+    total = total - counts[bucket] + count;
+    counts[bucket] = count;
+}
+
+double DurationHistogram::Quantile(double q) const
+{
+    if (total == 0) return 0.0;
+    const double rank = std::clamp(q, 0.0, 1.0) * static_cast<double>(total);
+    uint64_t seen = 0;
+    for (int i = 0; i < kBuckets; ++i) {
+        seen += counts[i];
+        if (counts[i] == 0 || static_cast<double>(seen) < rank) continue;
+        if (i == 0) return kFirstBucketMs / 2.0;
+        if (i == kBuckets - 1) return BucketUpperMs(i - 1);  // Open-ended; report where it starts
+        return std::sqrt(BucketUpperMs(i - 1) * BucketUpperMs(i));  // Middle of a log-spaced bucket
+    }
+    return BucketUpperMs(kBuckets - 2);
+}
+
+// ===== ShotAggregate =====
+
+void ShotAggregate::AddAttempt(bool scored, double durationMs)
+{
+    ShotAggregate one;
+    one.attempts = 1;
+    if (scored) {
+        one.goals = one.leadingGoals = one.trailingGoals = one.bestStreak = 1;
+        one.timeToGoal.Add(durationMs);
+    }
+    Merge(one);
+}
+
+void ShotAggregate::Merge(const ShotAggregate& later)
+{
+    bestStreak = std::max({ bestStreak, later.bestStreak, trailingGoals + later.leadingGoals });
+    // A run with no misses in it extends whatever streak it touches
+    if (goals == attempts) leadingGoals = attempts + later.leadingGoals;
+    trailingGoals = (later.goals == later.attempts) ? trailingGoals + later.attempts : later.trailingGoals;
+    attempts += later.attempts;
+    goals += later.goals;
+    timeToGoal.Merge(later.timeToGoal);
+}
+
+void PackShotStats::Merge(const PackShotStats& later)
+{
+    total.Merge(later.total);
+    if (rounds.size() < later.rounds.size()) rounds.resize(later.rounds.size());
+    for (size_t i = 0; i < later.rounds.size(); ++i) {
+        rounds[i].Merge(later.rounds[i]);
+    }
+}
+
+// ===== ShotStatsTracker =====
+
+ShotStatsTracker::ShotStatsTracker(const std::filesystem::path& dir)
+    : telemetryDir(dir)
+    , summaryPath(dir / "shot_stats.json")
+    , lastSave(std::chrono::steady_clock::now())
+{
+    Load();
+}
+
+ShotStatsTracker::~ShotStatsTracker()
+{
+    PendingSave save;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!liveSession.empty()) {
+            Close(sessions[liveSession]);
+        }
+        if (dirty) save = SnapshotLocked();
+    }
+    WriteSummary(save);
+}
+
+void ShotStatsTracker::Load()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    packs.clear();
+    sessions.clear();
+
+    std::error_code ec;
+    if (std::filesystem::exists(summaryPath, ec)) {
+        try {
+            std::ifstream file(summaryPath);
+            json j;
+            file >> j;
+            if (j.value("format", 0) == kFormat) {
+                if (j.contains("packs") && j["packs"].is_array()) {
+                    for (const auto& item : j["packs"]) {
+                        PackCode code;
+                        if (!PackCode::Parse(item.value("code", ""), code)) continue;
+                        PackShotStats& stats = packs[code];
+                        if (item.contains("total")) stats.total = AggregateFromJson(item["total"]);
+                        if (item.contains("rounds") && item["rounds"].is_array()) {
+                            for (const auto& round : item["rounds"]) {
+                                stats.rounds.push_back(AggregateFromJson(round));
+                            }
+                        }
+                    }
+                }
+                if (j.contains("sessions") && j["sessions"].is_object()) {
+                    for (const auto& [name, mark] : j["sessions"].items()) {
+                        SessionCursor& cursor = sessions[name];
+                        cursor.consumed = cursor.seen = mark.value("consumed", uint64_t{0});
+                        cursor.closed = mark.value("closed", false);
+                    }
+                }
+            } else {
+                LOG("ShotStats: Summary format changed; rebuilding from session files");
+            }
+        } catch (const std::exception& e) {
+            LOG("ShotStats: Error reading summary, rebuilding from session files: {}", e.what());
+            packs.clear();
+            sessions.clear();
+        }
+    }
+
+    CatchUp();
+    LOG("ShotStats: {} packs with shot history", packs.size());
+    if (dirty) {
+        PendingSave save = SnapshotLocked();
+        lock.unlock();
+        WriteSummary(save);
+    }
+}
+
+void ShotStatsTracker::CatchUp()
+{
+    std::error_code ec;
+    if (!std::filesystem::is_directory(telemetryDir, ec)) return;
+
+    // Oldest first, so streaks join up in the order the shots happened
+    std::vector<std::pair<std::string, ShotTelemetry::Session>> behind;
+    for (const auto& entry : std::filesystem::directory_iterator(telemetryDir, ec)) {
+        if (entry.path().extension() != ".shots") continue;
+        std::string name = entry.path().filename().string();
+        auto it = sessions.find(name);
+        if (it != sessions.end() && it->second.closed) continue;
+        ShotTelemetry::Session session;
+        if (!ShotTelemetry::ReadSessionFile(entry.path(), session)) continue;
+        behind.emplace_back(std::move(name), std::move(session));
+    }
+    std::sort(behind.begin(), behind.end(), [](const auto& a, const auto& b) {
+        return a.second.startUnixMs < b.second.startUnixMs;
+    });
+
+    for (const auto& [name, session] : behind) {
+        SessionCursor& cursor = sessions[name];
+        // Pick up at the last attempt that wasn't finished when the summary was saved
+        cursor.seen = cursor.consumed;
+        cursor.open = false;
+        for (uint64_t i = cursor.consumed; i < session.records.size(); ++i) {
+            Fold(cursor, session.records[static_cast<size_t>(i)]);
+        }
+        Close(cursor);
+        LOG("ShotStats: Caught up on {} ({} records)", name, session.records.size());
+    }
+
+    // Sessions whose file is gone have nothing more to give, and a closed one's mark would
+    // otherwise stay in the summary forever. (No session is live yet at load.)
+    for (auto it = sessions.begin(); it != sessions.end();) {
+        if (!std::filesystem::exists(telemetryDir / it->first, ec)) {
+            it = sessions.erase(it);
+            dirty = true;
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ShotStatsTracker::OnRecords(const std::filesystem::path& sessionFile,
+    const std::vector<ShotTelemetry::ShotRecord>& records)
+{
+    if (records.empty()) return;
+    PendingSave save;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        liveSession = sessionFile.filename().string();
+        SessionCursor& cursor = sessions[liveSession];
+        for (const auto& record : records) {
+            Fold(cursor, record);
+        }
+        version++;
+
+        if (std::chrono::steady_clock::now() - lastSave >= kSaveInterval) {
+            save = SnapshotLocked();
+        }
+    }
+    // Written without mutex_, so the browser's lookups never wait on the disk
+    WriteSummary(save);
+}
+
+void ShotStatsTracker::Fold(SessionCursor& cursor, const ShotTelemetry::ShotRecord& record)
+{
+    using ShotEvent = ShotTelemetry::ShotEvent;
+    const uint64_t index = cursor.seen++;
+    if (record.event == ShotEvent::Attempt) {
+        if (cursor.open) CloseAttempt(cursor.openAttempt, false, 0.0);
+        cursor.open = true;
+        cursor.openAttempt = record;
+        cursor.openIndex = index;
+    } else if (record.event == ShotEvent::Goal && cursor.open &&
+        record.packCode == cursor.openAttempt.packCode &&
+        record.round == cursor.openAttempt.round &&
+        record.attempt == cursor.openAttempt.attempt) {
+        CloseAttempt(cursor.openAttempt, true, (record.timeUs - cursor.openAttempt.timeUs) / 1000.0);
+        cursor.open = false;
+    }
+    cursor.consumed = cursor.open ? cursor.openIndex : cursor.seen;
+    dirty = true;
+}
+
+void ShotStatsTracker::Close(SessionCursor& cursor)
+{
+    if (cursor.open) {
+        CloseAttempt(cursor.openAttempt, false, 0.0);
+        cursor.open = false;
+    }
+    cursor.consumed = cursor.seen;
+    cursor.closed = true;
+    dirty = true;
+}
+
+void ShotStatsTracker::CloseAttempt(const ShotTelemetry::ShotRecord& attempt, bool scored, double durationMs)
+{
+    if (attempt.packCode == 0) return;  // Pack code couldn't be read; nothing to show it under
+
+    PackShotStats& stats = packs[PackCode(attempt.packCode)];
+    stats.total.AddAttempt(scored, durationMs);
+    if (attempt.round >= 0 && attempt.round < kMaxRounds) {
+        if (stats.rounds.size() <= static_cast<size_t>(attempt.round)) {
+            stats.rounds.resize(static_cast<size_t>(attempt.round) + 1);
+        }
+        stats.rounds[attempt.round].AddAttempt(scored, durationMs);
+    }
+}
+
+bool ShotStatsTracker::GetPackStats(const std::string& packCode, PackShotStats& out) const
+{
+    PackCode code;
+    if (!PackCode::Parse(packCode, code)) return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = packs.find(code);
+    if (it == packs.end()) return false;
+    out = it->second;
+    return true;
+}
+
+bool ShotStatsTracker::GetSummary(const std::string& packCode, PackShotSummary& out) const
+{
+    PackCode code;
+    if (!PackCode::Parse(packCode, code)) return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = packs.find(code);
+    if (it == packs.end() || it->second.total.attempts == 0) return false;
+
+    const ShotAggregate& total = it->second.total;
+    out = PackShotSummary{};
+    out.attempts = total.attempts;
+    out.goals = total.goals;
+    out.successRate = total.SuccessRate();
+    out.medianTimeToGoalMs = total.timeToGoal.Quantile(0.5);
+    out.p90TimeToGoalMs = total.timeToGoal.Quantile(0.9);
+    out.currentStreak = total.trailingGoals;
+    out.bestStreak = total.bestStreak;
+
+    const auto& rounds = it->second.rounds;
+    for (size_t i = 0; i < rounds.size(); ++i) {
+        if (rounds[i].attempts < kMinRoundAttempts) continue;
+        if (out.hardestRound < 0 || rounds[i].SuccessRate() < out.hardestRoundRate) {
+            out.hardestRound = static_cast<int>(i);
+            out.hardestRoundRate = rounds[i].SuccessRate();
+        }
+    }
+    return true;
+}
+
+void ShotStatsTracker::Save()
+{
+    PendingSave save;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        save = SnapshotLocked();
+    }
+    WriteSummary(save);
+}
+
+ShotStatsTracker::PendingSave ShotStatsTracker::SnapshotLocked()
+{
+    PendingSave save;
+    save.sequence = ++saveSequence;
+    save.summary["format"] = kFormat;
+
+    json packList = json::array();
+    for (const auto& [code, stats] : packs) {
+        json rounds = json::array();
+        for (const auto& round : stats.rounds) {
+            rounds.push_back(AggregateToJson(round));
+        }
+        packList.push_back({
+            {"code", code.ToString()},
+            {"total", AggregateToJson(stats.total)},
+            {"rounds", std::move(rounds)}
+        });
+    }
+    save.summary["packs"] = std::move(packList);
+
+    json marks = json::object();
+    for (const auto& [name, cursor] : sessions) {
+        marks[name] = { {"consumed", cursor.consumed}, {"closed", cursor.closed} };
+    }
+    save.summary["sessions"] = std::move(marks);
+
+    // Counted as saved from here; WriteSummary() marks it dirty again if the write fails
+    dirty = false;
+    lastSave = std::chrono::steady_clock::now();
+    return save;
+}
+
+void ShotStatsTracker::WriteSummary(const PendingSave& save)
+{
+    if (save.sequence == 0) return;
+
+    std::lock_guard<std::mutex> lock(fileMutex_);
+    // Two threads can snapshot and then reach here in either order; never put an older one back
+    if (save.sequence <= writtenSequence) return;
+
+    bool written = false;
+    try {
+        std::filesystem::create_directories(telemetryDir);
+        std::filesystem::path tmpPath = summaryPath;
+        tmpPath += ".tmp";
+        {
+            std::ofstream file(tmpPath);
+            if (!file.is_open()) {
+                LOG("ShotStats: Could not write {}", tmpPath.string());
+            } else {
+                file << save.summary.dump();
+            }
+            written = file.is_open() && static_cast<bool>(file);
+        }
+        if (written) {
+            std::filesystem::rename(tmpPath, summaryPath);
+            writtenSequence = save.sequence;
+        }
+    } catch (const std::exception& e) {
+        LOG("ShotStats: Error saving summary: {}", e.what());
+        written = false;
+    }
+
+    if (!written) {
+        std::lock_guard<std::mutex> stateLock(mutex_);
+        dirty = true;
+    }
+}
@@ -0,0 +1,161 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "PackCode.h"
+#include "ShotTelemetry.h"
+#include "IMGUI/json.hpp"
+
+/*
+ * ======================================================================================
+ * SHOT STATS: RUNNING TOTALS FROM THE SHOT TELEMETRY
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * Per pack, and per shot within a pack: how many attempts, how many went in, how long a
+ * successful attempt took (median / 90th percentile), and goal streaks. The browser shows
+ * them on hover and in the pack popup.
+ *
+ * WHY IS IT HERE?
+ * `ShotTelemetry` writes every attempt to a session file. Re-reading years of session files
+ * to answer "how am I doing on this pack?" would get slower every day. Instead the totals
+ * are kept up to date as shots come in and saved as one small summary
+ * (`Telemetry/shot_stats.json`); the raw files are only read if the summary is behind them.
+ *
+ * HOW DOES IT WORK?
+ * 1. `ShotAggregate` holds everything about a run of attempts in a fixed size, and two of
+ *    them merge into the aggregate of both runs (`Merge`). Counts add. Times-to-goal go in
+ *    a `DurationHistogram` of fixed log-spaced buckets (each ~19% wider than the last), so
+ *    merging is adding bucket counts and a percentile is one walk over 40 buckets.
+ *    Streaks merge like runs of text: keep the goals at the start, at the end, and the best
+ *    run inside; joining A then B can make a new best out of A's end + B's start.
+ * 2. Folding a record: an Attempt opens a shot, a Goal for that shot closes it as a goal
+ *    (time = goal - attempt start), and the next Attempt closes an open one as a miss.
+ *    Each closed shot is merged into its pack's total and its round's aggregate.
+ * 3. `ShotTelemetry` hands every block it writes to `OnRecords()`, on its writer thread.
+ *    The summary is saved (temp file + rename) at most every `kSaveInterval` and on
+ *    destruction, and remembers how many records of each session file it includes. It's
+ *    copied under the lock and written after, so lookups never wait on the disk. On
+ *    load, any session file the summary is behind on is folded from where it stopped, so
+ *    a crash loses nothing and nothing is counted twice.
+ * 4. Lookups are a hash of the pack code and a fixed amount of math, whatever the history.
+ */
+
+class DurationHistogram {
+public:
+    static constexpr int kBuckets = 40;
+    static constexpr double kFirstBucketMs = 100.0;  // Bucket 0 is everything up to this
+    static constexpr double kBucketsPerDoubling = 4.0;  // Last bucket starts at ~72 s
+
+    void Add(double ms, uint32_t count = 1);
+    void Merge(const DurationHistogram& other);
+    uint64_t Count() const { return total; }
+    double Quantile(double q) const;  // In ms; 0 when empty
+
+    const std::array<uint32_t, kBuckets>& Buckets() const { return counts; }
+    void SetBucket(int bucket, uint32_t count);  // For loading
+
+private:
+    static double BucketUpperMs(int bucket);
+
+    std::array<uint32_t, kBuckets> counts{};
+    uint64_t total = 0;
+};
+
+struct ShotAggregate {
+    uint32_t attempts = 0;
+    uint32_t goals = 0;
+    uint32_t leadingGoals = 0;   // Goals before the first miss
+    uint32_t trailingGoals = 0;  // Goals since the last miss (the current streak)
+    uint32_t bestStreak = 0;
+    DurationHistogram timeToGoal;
+
+    void AddAttempt(bool scored, double durationMs);
+    void Merge(const ShotAggregate& later);  // `later` happened after everything in *this
+    double SuccessRate() const { return attempts ? double(goals) / attempts : 0.0; }
+};
+
+struct PackShotStats {
+    ShotAggregate total;
+    std::vector<ShotAggregate> rounds;  // Indexed by round; grows to the highest round seen
+
+    void Merge(const PackShotStats& later);
+};
+
+// What the browser shows for one pack
+struct PackShotSummary {
+    uint32_t attempts = 0;
+    uint32_t goals = 0;
+    double successRate = 0.0;
+    double medianTimeToGoalMs = 0.0;
+    double p90TimeToGoalMs = 0.0;
+    uint32_t currentStreak = 0;
+    uint32_t bestStreak = 0;
+    int hardestRound = -1;            // Lowest success rate among rounds with enough attempts
+    double hardestRoundRate = 0.0;
+};
+
+class ShotStatsTracker {
+public:
+    explicit ShotStatsTracker(const std::filesystem::path& telemetryDir);
+    ~ShotStatsTracker();  // Closes the live session and saves
+
+    // ShotTelemetry's record sink (its writer thread)
+    void OnRecords(const std::filesystem::path& sessionFile, const std::vector<ShotTelemetry::ShotRecord>& records);
+
+    bool GetSummary(const std::string& packCode, PackShotSummary& out) const;  // False if never played
+    bool GetPackStats(const std::string& packCode, PackShotStats& out) const;
+    uint64_t GetVersion() const { return version; }  // Goes up whenever the stats change
+
+    void Save();
+
+    static constexpr std::chrono::seconds kSaveInterval{30};
+    static constexpr uint32_t kMinRoundAttempts = 5;  // Before a round can be "hardest"
+
+private:
+    // How far the stats have got through one session file
+    struct SessionCursor {
+        uint64_t seen = 0;        // Records folded so far
+        uint64_t consumed = 0;    // Records whose effect is fully in the stats
+        bool closed = false;      // Session is over; its file never needs reading again
+        bool open = false;        // An attempt that hasn't scored or been followed yet
+        uint64_t openIndex = 0;
+        ShotTelemetry::ShotRecord openAttempt;
+    };
+
+    void Load();
+    void CatchUp();  // Folds session files the summary is behind on; caller holds mutex_
+    void Fold(SessionCursor& cursor, const ShotTelemetry::ShotRecord& record);  // Caller holds mutex_
+    void Close(SessionCursor& cursor);  // Open attempt becomes a miss; caller holds mutex_
+    void CloseAttempt(const ShotTelemetry::ShotRecord& attempt, bool scored, double durationMs);
+
+    // A copy of the summary taken under mutex_, written to disk after it's released
+    struct PendingSave {
+        nlohmann::json summary;
+        uint64_t sequence = 0;  // 0 = nothing to write
+    };
+    PendingSave SnapshotLocked();  // Caller holds mutex_
+    void WriteSummary(const PendingSave& save);  // Caller does not hold mutex_
+
+    std::filesystem::path telemetryDir;
+    std::filesystem::path summaryPath;
+
+    mutable std::mutex mutex_;  // Protects everything below
+    std::unordered_map<PackCode, PackShotStats> packs;
+    std::map<std::string, SessionCursor> sessions;  // By session file name
+    std::string liveSession;
+    bool dirty = false;
+    std::chrono::steady_clock::time_point lastSave;
+    uint64_t saveSequence = 0;  // Snapshots taken
+    std::atomic<uint64_t> version{0};
+
+    std::mutex fileMutex_;  // One summary write at a time; taken without mutex_ held
+    uint64_t writtenSequence = 0;  // fileMutex_; newest snapshot on disk
+};
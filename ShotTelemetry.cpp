@@ -0,0 +1,273 @@
+#include "pch.h"
+#include "ShotTelemetry.h"
+#include "logging.h"
+
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+    constexpr uint32_t kFileMagic = 0x4C545353;   // "SSTL" little-endian
+    constexpr uint32_t kBlockMagic = 0x4B4C4253;  // "SBLK"
+    constexpr uint32_t kVersion = 1;
+
+    struct FileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        int64_t startUnixMs;    // Wall clock when the session started; record times count from here
+    };
+
+    // Followed by `count` pack codes, then `count` times, rounds, total rounds, attempts, events
+    struct BlockHeader
+    {
+        uint32_t magic;
+        uint32_t count;
+        uint64_t checksum;      // FNV-1a over the columns
+    };
+
+    static_assert(sizeof(FileHeader) == 16, "Telemetry header layout changed; bump kVersion");
+    static_assert(sizeof(BlockHeader) == 16, "Telemetry block layout changed; bump kVersion");
+
+    constexpr size_t kColumnBytes = sizeof(uint64_t) + sizeof(int64_t) + sizeof(int16_t) * 2 +
+        sizeof(uint16_t) + sizeof(uint8_t);
+
+    uint64_t Fnv1a(const uint8_t* data, size_t size)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ data[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // Appends one field of every record, back to back
+    template <typename T, typename Get>
+    void AppendColumn(std::vector<uint8_t>& out, const std::vector<ShotTelemetry::ShotRecord>& records, Get get)
+    {
+        const size_t at = out.size();
+        out.resize(at + records.size() * sizeof(T));
+        uint8_t* dst = out.data() + at;
+        for (const auto& r : records) {
+            const T value = get(r);
+            std::memcpy(dst, &value, sizeof(T));
+            dst += sizeof(T);
+        }
+    }
+
+    template <typename T, typename Set>
+    const uint8_t* ReadColumn(const uint8_t* src, std::vector<ShotTelemetry::ShotRecord>& records, size_t first, Set set)
+    {
+        for (size_t i = first; i < records.size(); ++i) {
+            T value;
+            std::memcpy(&value, src, sizeof(T));
+            set(records[i], value);
+            src += sizeof(T);
+        }
+        return src;
+    }
+
+    std::filesystem::path NewSessionPath(const std::filesystem::path& dir)
+    {
+        const std::time_t now = std::time(nullptr);
+        std::ostringstream name;
+        name << "session-" << std::put_time(std::localtime(&now), "%Y%m%d-%H%M%S");
+        std::filesystem::path path = dir / (name.str() + ".shots");
+        // Two sessions in the same second (a quick plugin reload) get their own files
+        std::error_code ec;
+        for (int n = 2; std::filesystem::exists(path, ec); ++n) {
+            path = dir / (name.str() + "-" + std::to_string(n) + ".shots");
+        }
+        return path;
+    }
+}
+
+ShotTelemetry::ShotTelemetry(const std::filesystem::path& dir, RecordSink recordSink)
+    : telemetryDir(dir)
+    , sink(std::move(recordSink))
+    , sessionStart(std::chrono::steady_clock::now())
+{
+    sessionStartUnixMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    sessionPath = NewSessionPath(telemetryDir);
+    pending.reserve(kCapacity);
+    writerThread = std::thread([this]() { WriterLoop(); });
+}
+
+ShotTelemetry::~ShotTelemetry()
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopWriter = true;
+    }
+    wake.notify_one();
+    if (writerThread.joinable()) {
+        writerThread.join();
+    }
+    Flush();
+}
+
+void ShotTelemetry::BeginPack(PackCode code)
+{
+    packActive = true;
+    attemptOpen = false;
+    current = ShotRecord{};
+    current.packCode = code.Value();
+}
+
+void ShotTelemetry::EndPack()
+{
+    packActive = false;
+    attemptOpen = false;
+}
+
+void ShotTelemetry::RecordAttempt(int round, int totalRounds)
+{
+    if (!packActive) return;
+
+    const auto r = static_cast<int16_t>(round);
+    current.attempt = (r == current.round) ? static_cast<uint16_t>(current.attempt + 1) : 1;
+    current.round = r;
+    current.totalRounds = static_cast<int16_t>(totalRounds);
+    attemptOpen = true;
+    Push(ShotEvent::Attempt);
+}
+
+void ShotTelemetry::RecordGoal()
+{
+    if (!packActive || !attemptOpen) return;
+    attemptOpen = false;  // The same shot can't score twice
+    Push(ShotEvent::Goal);
+}
+
+void ShotTelemetry::Push(ShotEvent event)
+{
+    const uint64_t head = writeIndex.load(std::memory_order_relaxed);
+    if (head - readIndex.load(std::memory_order_acquire) >= kCapacity) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ShotRecord& slot = ring[head & (kCapacity - 1)];
+    slot = current;
+    slot.event = event;
+    slot.timeUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - sessionStart).count();
+    writeIndex.store(head + 1, std::memory_order_release);
+    recorded.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ShotTelemetry::Flush()
+{
+    std::lock_guard<std::mutex> lock(fileMutex);
+    WriteBlock();
+}
+
+void ShotTelemetry::WriterLoop()
+{
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    while (!stopWriter) {
+        // The game thread never signals (that would cost it a syscall), so just poll
+        wake.wait_for(lock, kWriteInterval, [this]() { return stopWriter; });
+        if (stopWriter) break;
+        lock.unlock();
+        Flush();
+        lock.lock();
+    }
+}
+
+void ShotTelemetry::WriteBlock()
+{
+    const uint64_t tail = readIndex.load(std::memory_order_relaxed);
+    const uint64_t head = writeIndex.load(std::memory_order_acquire);
+    if (head == tail) return;
+
+    pending.clear();
+    for (uint64_t i = tail; i != head; ++i) {
+        pending.push_back(ring[i & (kCapacity - 1)]);
+    }
+    // Slots are copied out, so the game thread may reuse them
+    readIndex.store(head, std::memory_order_release);
+
+    if (sink) {
+        try {
+            sink(sessionPath, pending);
+        } catch (const std::exception& e) {
+            LOG("ShotTelemetry: Record sink failed: {}", e.what());
+        }
+    }
+
+    if (fileFailed) return;  // Keep draining so the hooks never see a full ring
+
+    try {
+        if (!file.is_open()) {
+            std::filesystem::create_directories(telemetryDir);
+            file.open(sessionPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                LOG("ShotTelemetry: Could not create {}", sessionPath.string());
+                fileFailed = true;
+                return;
+            }
+            const FileHeader header{ kFileMagic, kVersion, sessionStartUnixMs };
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+
+        std::vector<uint8_t> columns;
+        columns.reserve(pending.size() * kColumnBytes);
+        AppendColumn<uint64_t>(columns, pending, [](const ShotRecord& r) { return r.packCode; });
+        AppendColumn<int64_t>(columns, pending, [](const ShotRecord& r) { return r.timeUs; });
+        AppendColumn<int16_t>(columns, pending, [](const ShotRecord& r) { return r.round; });
+        AppendColumn<int16_t>(columns, pending, [](const ShotRecord& r) { return r.totalRounds; });
+        AppendColumn<uint16_t>(columns, pending, [](const ShotRecord& r) { return r.attempt; });
+        AppendColumn<uint8_t>(columns, pending, [](const ShotRecord& r) { return static_cast<uint8_t>(r.event); });
+
+        const BlockHeader block{ kBlockMagic, static_cast<uint32_t>(pending.size()),
+            Fnv1a(columns.data(), columns.size()) };
+        file.write(reinterpret_cast<const char*>(&block), sizeof(block));
+        file.write(reinterpret_cast<const char*>(columns.data()), static_cast<std::streamsize>(columns.size()));
+        file.flush();
+        if (!file) {
+            LOG("ShotTelemetry: Write to {} failed; telemetry off for this session", sessionPath.string());
+            fileFailed = true;
+        }
+    } catch (const std::exception& e) {
+        LOG("ShotTelemetry: Error writing {}: {}", sessionPath.string(), e.what());
+        fileFailed = true;
+    }
+}
+
+bool ShotTelemetry::ReadSessionFile(const std::filesystem::path& path, Session& out)
+{
+    out = Session{};
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    FileHeader header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != kFileMagic || header.version != kVersion) {
+        return false;
+    }
+    out.startUnixMs = header.startUnixMs;
+
+    std::vector<uint8_t> columns;
+    BlockHeader block{};
+    while (in.read(reinterpret_cast<char*>(&block), sizeof(block))) {
+        if (block.magic != kBlockMagic || block.count == 0) break;
+        columns.resize(static_cast<size_t>(block.count) * kColumnBytes);
+        if (!in.read(reinterpret_cast<char*>(columns.data()), static_cast<std::streamsize>(columns.size()))) break;
+        if (Fnv1a(columns.data(), columns.size()) != block.checksum) break;
+
+        const size_t first = out.records.size();
+        out.records.resize(first + block.count);
+        const uint8_t* src = columns.data();
+        src = ReadColumn<uint64_t>(src, out.records, first, [](ShotRecord& r, uint64_t v) { r.packCode = v; });
+        src = ReadColumn<int64_t>(src, out.records, first, [](ShotRecord& r, int64_t v) { r.timeUs = v; });
+        src = ReadColumn<int16_t>(src, out.records, first, [](ShotRecord& r, int16_t v) { r.round = v; });
+        src = ReadColumn<int16_t>(src, out.records, first, [](ShotRecord& r, int16_t v) { r.totalRounds = v; });
+        src = ReadColumn<uint16_t>(src, out.records, first, [](ShotRecord& r, uint16_t v) { r.attempt = v; });
+        ReadColumn<uint8_t>(src, out.records, first, [](ShotRecord& r, uint8_t v) { r.event = static_cast<ShotEvent>(v); });
+    }
+    return true;
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "PackCode.h"
+
+/*
+ * ======================================================================================
+ * SHOT TELEMETRY: ONE SMALL RECORD PER TRAINING SHOT
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * Records every custom training shot attempt (and every goal scored during one) to a
+ * session file under `SuiteTraining/Telemetry/`: which pack, which round, when, and
+ * whether it went in.
+ *
+ * WHY IS IT HERE?
+ * The records come from game hooks (`TrainingShotAttempt`, `Ball_TA.OnHitGoal`), which run
+ * on the game thread in the middle of a frame. Recording one must cost next to nothing:
+ * no locks, no allocation, no file I/O, no waking another thread.
+ *
+ * HOW DOES IT WORK?
+ * 1. A record is 24 bytes (`ShotRecord`). The game thread copies it into a fixed ring of
+ *    `kCapacity` slots and bumps an index; that is the whole cost of a shot. The pack code
+ *    is looked up once per pack (`BeginPack()`), not once per shot.
+ * 2. Only the game thread writes the ring and only the writer thread reads it, so two
+ *    atomic indexes are enough (no compare-and-swap). If the writer ever falls a whole ring
+ *    behind, new records are dropped and counted rather than waiting.
+ * 3. Goals aren't their own shots: a Goal record repeats the round and attempt of the shot
+ *    it ended. An attempt with no Goal after it (before the next attempt) was a miss.
+ * 4. Every `kWriteInterval` the writer takes whatever is in the ring and appends it to the
+ *    session file as one block, column by column (all pack codes, then all times, ...), so
+ *    a reader can pull a single column without decoding whole records. Each block carries
+ *    its own checksum, so a block cut short by a crash is ignored on read. The same block
+ *    goes to the optional sink (`ShotStatsTracker` keeps running totals from it).
+ * 5. Times are microseconds since the session started (steady clock, so changing the system
+ *    clock can't reorder shots). The session's wall-clock start is in the file header.
+ */
+
+class ShotTelemetry {
+public:
+    enum class ShotEvent : uint8_t {
+        Attempt = 0,  // Player started moving on a shot
+        Goal = 1,     // The ball went in during the last attempt
+    };
+
+    struct ShotRecord {
+        uint64_t packCode = 0;     // PackCode bits; 0 = the code couldn't be read
+        int64_t timeUs = 0;        // Since the session started
+        int16_t round = -1;        // 0-based shot index within the pack
+        int16_t totalRounds = 0;
+        uint16_t attempt = 0;      // 1 for the first try at this round, counting up
+        ShotEvent event = ShotEvent::Attempt;
+        uint8_t reserved = 0;
+    };
+    static_assert(sizeof(ShotRecord) == 24, "Ring slot grew; keep records small");
+
+    struct Session {
+        int64_t startUnixMs = 0;
+        std::vector<ShotRecord> records;
+    };
+
+    // Gets every block of records as it's written (session file, records), on the writer thread
+    using RecordSink = std::function<void(const std::filesystem::path&, const std::vector<ShotRecord>&)>;
+
+    explicit ShotTelemetry(const std::filesystem::path& telemetryDir, RecordSink sink = nullptr);
+    ~ShotTelemetry();  // Writes what's left in the ring and closes the session file
+
+    // Game thread only (hooks and SetTimeout callbacks)
+    void BeginPack(PackCode code);  // A pack was (re)started; attempt counts start over
+    void EndPack();                 // Forget the current pack until BeginPack() again
+    bool HasPack() const { return packActive; }
+    void RecordAttempt(int round, int totalRounds);
+    void RecordGoal();              // Ignored unless an attempt is in progress
+
+    void Flush();  // Writes buffered records now (any thread)
+
+    uint64_t GetRecordedCount() const { return recorded.load(std::memory_order_relaxed); }
+    uint64_t GetDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+    std::filesystem::path GetSessionPath() const { return sessionPath; }
+
+    // Reads a whole session file; stops at the first damaged block, keeping the ones before it
+    static bool ReadSessionFile(const std::filesystem::path& path, Session& out);
+
+    static constexpr size_t kCapacity = 4096;  // Power of two; ~100 KB of records
+    static constexpr std::chrono::seconds kWriteInterval{2};
+
+private:
+    static_assert((kCapacity & (kCapacity - 1)) == 0, "kCapacity must be a power of two");
+
+    void Push(ShotEvent event);  // Copies the current shot into the ring
+    void WriterLoop();
+    void WriteBlock();  // Ring -> session file; caller holds fileMutex
+
+    std::filesystem::path telemetryDir;
+    std::filesystem::path sessionPath;
+    RecordSink sink;
+    std::chrono::steady_clock::time_point sessionStart;
+    int64_t sessionStartUnixMs = 0;
+
+    // Game thread state
+    bool packActive = false;
+    bool attemptOpen = false;  // An attempt has started and hasn't scored yet
+    ShotRecord current;        // The shot being played
+
+    // Single producer (game thread), single consumer (writer); indexes only ever grow
+    std::array<ShotRecord, kCapacity> ring{};
+    alignas(64) std::atomic<uint64_t> writeIndex{0};
+    alignas(64) std::atomic<uint64_t> readIndex{0};
+    std::atomic<uint64_t> recorded{0};
+    std::atomic<uint64_t> dropped{0};
+
+    std::mutex fileMutex;  // One block writer at a time; protects below
+    std::ofstream file;
+    bool fileFailed = false;
+    std::vector<ShotRecord> pending;  // Reused drain buffer
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    bool stopWriter = false;  // wakeMutex
+    std::thread writerThread;
+};
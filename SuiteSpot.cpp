@@ -69,15 +69,50 @@ std::filesystem::path SuiteSpot::ResolveConfiguredWorkshopRoot() const {
 void SuiteSpot::DiscoverWorkshopInDir(const std::filesystem::path& dir) {
     if (mapManager) {
         mapManager->DiscoverWorkshopInDir(dir, RLWorkshop);
+        ++workshopVersion;
     }
 }
 
 void SuiteSpot::LoadWorkshopMaps() {
-    if (mapManager) {
-        // Load workshop maps without passing an index - the path-based selection persists automatically
-        int unused = 0;
-        mapManager->LoadWorkshopMaps(RLWorkshop, unused);
+    if (!mapManager) {
+        return;
     }
+    if (workshopLoadState == CatalogLoadState::Loading) {
+        LOG("SuiteSpot: Workshop scan already in progress");
+        return;
+    }
+
+    // The previous scan has finished (state isn't Loading), so this join is immediate
+    if (workshopScanThread.joinable()) {
+        workshopScanThread.join();
+    }
+
+    workshopLoadState = CatalogLoadState::Loading;
+
+    // Walking the mod folders and reading each map's JSON happens off the game thread.
+    // The finished list replaces RLWorkshop on the game thread, so hooks never see it half-built.
+    workshopScanThread = std::thread([this]() {
+        auto maps = std::make_shared<std::vector<WorkshopEntry>>();
+        try {
+            // Load workshop maps without passing an index - the path-based selection persists automatically
+            int unused = 0;
+            mapManager->LoadWorkshopMaps(*maps, unused);
+        } catch (const std::exception& e) {
+            LOG("SuiteSpot: Workshop scan failed: {}", std::string(e.what()));
+            workshopLoadState = CatalogLoadState::Failed;
+            return;
+        }
+
+        // The plugin can be unloaded before the game thread gets to this; onUnload drops the token
+        std::weak_ptr<bool> alive = workshopAlive;
+        gameWrapper->Execute([this, maps, alive](GameWrapper* gw) {
+            if (alive.expired()) return;
+            RLWorkshop = std::move(*maps);
+            ++workshopVersion;
+            workshopLoadState = CatalogLoadState::Ready;
+            LOG("SuiteSpot: Found {} workshop maps", RLWorkshop.size());
+        });
+    });
 }
 
 // ===== TRAINING PACK UPDATE INTEGRATION =====
@@ -122,27 +157,24 @@ std::string SuiteSpot::GetCurrentWorkshopPath() const {
 }
 
 // #detailed comments: UpdateTrainingPackList
-// Purpose: Launches an external PowerShell script to download the latest
-// training pack data and write a JSON cache to disk. This is intentionally
-// performed in a background task to avoid any blocking on the UI/game thread.
+// Purpose: Downloads the latest training pack data (PackScraper, on a
+// background thread inside TrainingPackManager), writes the JSON cache to
+// disk and merges the changes into the loaded catalog.
 //
 // Safety and behavior notes:
 //  - scrapingInProgress is a guard flag ensuring only one update
-//    runs at a time. It is set before launching and cleared when the
-//    background process finishes.
-//  - The implementation uses system() and relies on the platform's
-//    default process creation semantics; this must remain as-is for
-//    portability with existing deployments. If this is changed to a
-//    more advanced process API, ensure identical detach/exit semantics.
-//  - The script path is hard-coded to the repo dev path; callers should
-//    ensure that the script is present when invoking this routine.
-//
-// DO NOT CHANGE: Modifying the background thread logic or the way the
-// result is checked could resurface race conditions that previously
-// required this exact coordination.
-void SuiteSpot::UpdateTrainingPackList() {
+//    runs at a time. It is set before the thread starts and cleared when
+//    the download and merge have finished.
+//  - The source page comes from the suitespot_pack_source_url cvar, so the
+//    updater can be pointed at a mirror or a local copy of the site.
+//  - A download with pages missing is discarded; the current list stays.
+//  - By default only the newest pages are fetched, until known packs come
+//    back (quick sync). fullSync, a source change or a pack file layout
+//    change (PackSyncState) downloads every page instead.
+void SuiteSpot::UpdateTrainingPackList(bool fullSync) {
     if (trainingPackMgr) {
-        trainingPackMgr->UpdateTrainingPackList(GetTrainingPacksPath(), gameWrapper);
+        trainingPackMgr->UpdateTrainingPackList(GetTrainingPacksPath(), gameWrapper,
+                                                settingsSync ? settingsSync->GetPackSourceUrl() : "", fullSync);
     }
 }
 
@@ -176,6 +208,8 @@ void SuiteSpot::LoadHooks() {
         "Function TAGame.GameEvent_TrainingEditor_TA.OnInit",
         [this](std::string eventName) {
             LOG("Hook triggered: GameEvent_TrainingEditor_TA.OnInit");
+            // A new or restarted pack; the next shot looks its code up again
+            if (shotTelemetry) shotTelemetry->EndPack();
             gameWrapper->SetTimeout([this](GameWrapper* gw) {
                 TryHealCurrentPack(gw);
             }, 1.5f);
@@ -187,8 +221,17 @@ void SuiteSpot::LoadHooks() {
     gameWrapper->HookEventPost(
         "Function TAGame.TrainingEditorMetrics_TA.TrainingShotAttempt",
         [this](std::string eventName) {
-            LOG("Hook triggered: TrainingEditorMetrics_TA.TrainingShotAttempt");
-            // Note: This hook exists but is not currently used for auto-heal
+            RecordShotAttempt();
+        }
+    );
+
+    // Hook: Ball went in. In custom training this ends the current shot attempt as a goal
+    gameWrapper->HookEventPost(
+        "Function TAGame.Ball_TA.OnHitGoal",
+        [this](std::string eventName) {
+            if (shotTelemetry && gameWrapper->IsInCustomTraining()) {
+                shotTelemetry->RecordGoal();
+            }
         }
     );
     
@@ -223,8 +266,12 @@ void SuiteSpot::GameEndedEvent(std::string name) {
         TrainingEntry selectedBagPack;  // Empty
         const bool useBagRotation = false;
 
-        autoLoadFeature->OnMatchEnded(gameWrapper, cvarManager, RLMaps, RLTraining, RLWorkshop,
-            useBagRotation, selectedBagPack, *settingsSync, usageTracker.get());
+        // Pack names come from whatever catalog was published last; a load still in
+        // progress doesn't block the match end
+        const bool workshopReady = workshopLoadState != CatalogLoadState::Loading;
+
+        autoLoadFeature->OnMatchEnded(gameWrapper, cvarManager, RLMaps, trainingPackMgr.get(), RLWorkshop,
+            workshopReady, useBagRotation, selectedBagPack, *settingsSync, usageTracker.get());
 
         // Increment usage count for training packs
         if (settingsSync->GetMapType() == 1) {
@@ -244,6 +291,31 @@ void SuiteSpot::GameEndedEvent(std::string name) {
 }
 
 // Helper method to extract and heal pack data from current training session
+// #detailed comments: RecordShotAttempt
+// Purpose: Adds one record to the shot telemetry each time a training shot
+// starts. This runs on the game thread on every shot, so it doesn't log and
+// only reads two ints from the editor; the pack code (a string conversion) is
+// read once per pack, on its first shot.
+void SuiteSpot::RecordShotAttempt() {
+    if (!shotTelemetry || !gameWrapper->IsInCustomTraining()) return;
+
+    auto server = gameWrapper->GetGameEventAsServer();
+    if (!server) return;
+    TrainingEditorWrapper editor(server.memory_address);
+    if (!editor) return;
+
+    if (!shotTelemetry->HasPack()) {
+        PackCode code;  // Stays 0 if the code can't be read; the shots still count
+        auto trainingData = editor.GetTrainingData();
+        if (trainingData) {
+            auto saveData = trainingData.GetTrainingData();
+            if (saveData) PackCode::Parse(saveData.GetCode().ToString(), code);
+        }
+        shotTelemetry->BeginPack(code);
+    }
+    shotTelemetry->RecordAttempt(editor.GetActiveRoundNumber(), editor.GetTotalRounds());
+}
+
 void SuiteSpot::TryHealCurrentPack(GameWrapper* gw) {
     if (!trainingPackMgr) {
         LOG("SuiteSpot: TryHealCurrentPack - trainingPackMgr is null");
@@ -312,8 +384,17 @@ void SuiteSpot::TryHealCurrentPack(GameWrapper* gw) {
     }
     
     LOG("SuiteSpot: [OK] Successfully extracted pack data - Code: {}, Shots: {}", code, realShots);
+
+    // Also pick up text the catalog may be missing; HealPack only uses it to fill blanks
+    PackHarvest harvest;
+    harvest.code = code;
+    harvest.shots = realShots;
+    harvest.creator = saveData.GetCreatorName().ToString();
+    harvest.description = saveData.GetDescription().ToString();
+
+    // Updates the catalog now; the disk write is queued and batched off the game thread
     LOG("SuiteSpot: Calling HealPack...");
-    trainingPackMgr->HealPack(code, realShots);
+    trainingPackMgr->HealPack(harvest);
 }
 
 void SuiteSpot::onLoad() {
@@ -328,7 +409,7 @@ void SuiteSpot::onLoad() {
     loadoutUI = std::make_unique<LoadoutUI>(this);
 
     EnsureDataDirectories();
-    LoadWorkshopMaps();
+    LoadWorkshopMaps();  // Background scan; the workshop list fills in when it's done
     
     // Initialize LoadoutManager
     loadoutManager = std::make_unique<LoadoutManager>(gameWrapper);
@@ -338,6 +419,17 @@ void SuiteSpot::onLoad() {
     usageTracker = std::make_unique<PackUsageTracker>(GetSuiteTrainingDir() / "pack_usage_stats.json");
     LOG("SuiteSpot: PackUsageTracker initialized");
 
+    // Initialize ShotStatsTracker + ShotTelemetry (the session file is only created once a
+    // shot is recorded; every block written is also folded into the running stats)
+    const auto telemetryDir = GetSuiteTrainingDir() / "Telemetry";
+    shotStats = std::make_unique<ShotStatsTracker>(telemetryDir);
+    ShotStatsTracker* stats = shotStats.get();
+    shotTelemetry = std::make_unique<ShotTelemetry>(telemetryDir,
+        [stats](const std::filesystem::path& session, const std::vector<ShotTelemetry::ShotRecord>& records) {
+            stats->OnRecords(session, records);
+        });
+    LOG("SuiteSpot: ShotTelemetry initialized");
+
     // Initialize WorkshopDownloader
     workshopDownloader = std::make_shared<WorkshopDownloader>(gameWrapper);
     LOG("SuiteSpot: WorkshopDownloader initialized");
@@ -353,9 +445,9 @@ void SuiteSpot::onLoad() {
             LOG("SuiteSpot: No Pack cache found. Schedule scraping on next opportunity.");
             // Will be scraped on first Settings render or user request
         } else {
-            // Load existing Pack cache
-            trainingPackMgr->LoadPacksFromFile(GetTrainingPacksPath());
-            LOG("SuiteSpot: Pack cache loaded");
+            // Load existing Pack cache in the background; the browser shows progress meanwhile
+            trainingPackMgr->LoadPacksAsync(GetTrainingPacksPath());
+            LOG("SuiteSpot: Pack cache loading in background");
         }
     }
     
@@ -363,6 +455,16 @@ void SuiteSpot::onLoad() {
 
     if (settingsSync) {
         settingsSync->RegisterAllCVars(cvarManager);
+
+        // Favorites are ranked inside the tracker, so it needs the half-life as it changes,
+        // and once now for the value saved in the config (which may not fire the callback)
+        CVarWrapper halfLifeCvar = cvarManager->getCvar("suitespot_favorites_half_life_days");
+        halfLifeCvar.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
+            if (usageTracker) usageTracker->SetHalfLifeDays(cvar.getIntValue());
+        });
+        if (usageTracker && halfLifeCvar) {
+            usageTracker->SetHalfLifeDays(halfLifeCvar.getIntValue());
+        }
         
         // Auto-download textures if enabled
         if (settingsSync->IsAutoDownloadTextures() && textureDownloader) {
@@ -410,19 +512,33 @@ void SuiteSpot::onUnload() {
         textureDownloadThread.join();
     }
 
+    // Wait for startup loads that may still be reading from disk
+    if (workshopScanThread.joinable()) {
+        workshopScanThread.join();
+    }
+    workshopAlive.reset();  // A finished scan's queued swap into RLWorkshop now does nothing
+    if (trainingPackMgr) {
+        trainingPackMgr->WaitForLoad();
+        // A running pack update stops at its next request; it merges nothing once cancelled
+        trainingPackMgr->CancelUpdate();
+        trainingPackMgr->WaitForUpdate();
+    }
+
     // Stop workshop downloader search thread
     if (workshopDownloader) {
         workshopDownloader->StopSearch();
     }
 
-    if (usageTracker) {
-        usageTracker->SaveStats();
+    // Write any heals still waiting out their quiet period
+    if (trainingPackMgr) {
+        trainingPackMgr->FlushPendingHeals();
     }
 
     // STEP 3: Unhook all game events (CRITICAL - SDK requirement)
     gameWrapper->UnhookEventPost("Function TAGame.GameEvent_Soccar_TA.EventMatchEnded");
     gameWrapper->UnhookEventPost("Function TAGame.GameEvent_TrainingEditor_TA.OnInit");
     gameWrapper->UnhookEventPost("Function TAGame.TrainingEditorMetrics_TA.TrainingShotAttempt");
+    gameWrapper->UnhookEventPost("Function TAGame.Ball_TA.OnHitGoal");
     LOG("Event hooks removed");
 
     // STEP 4: Reset UI components (releases ImGui resources)
@@ -433,6 +549,9 @@ void SuiteSpot::onUnload() {
 
     // STEP 5: Reset data managers
     trainingPackMgr.reset();
+    usageTracker.reset();   // Stops its flusher and writes the final snapshot
+    shotTelemetry.reset();  // Writes the last shots; hooks are gone so nothing adds more
+    shotStats.reset();      // After the telemetry, which feeds it the last shots
     autoLoadFeature.reset();
     settingsSync.reset();
     mapManager.reset();
@@ -576,7 +695,7 @@ std::filesystem::path SuiteSpot::GetTrainingPacksPath() const
 void SuiteSpot::LoadTrainingPacksFromFile(const std::filesystem::path& filePath)
 {
     if (trainingPackMgr) {
-        trainingPackMgr->LoadPacksFromFile(filePath);
+        trainingPackMgr->LoadPacksAsync(filePath);
     }
 }
 
@@ -36,6 +36,8 @@
 #include "MapList.h"
 #include "LoadoutManager.h"
 #include "PackUsageTracker.h"
+#include "ShotTelemetry.h"
+#include "ShotStats.h"
 #include "TextureDownloader.h"
 #include "version.h"
 #include <filesystem>
@@ -94,7 +96,9 @@ public:
     std::filesystem::path GetSuiteTrainingDir() const;
 
     // Workshop persistence API
-    void LoadWorkshopMaps();
+    void LoadWorkshopMaps();  // Rescans on a worker thread; RLWorkshop is replaced on the game thread
+    CatalogLoadState GetWorkshopLoadState() const { return workshopLoadState; }
+    uint64_t GetWorkshopVersion() const { return workshopVersion; }  // Goes up whenever RLWorkshop changes
     void DiscoverWorkshopInDir(const std::filesystem::path& dir);
     std::filesystem::path GetWorkshopLoaderConfigPath() const;
     std::filesystem::path ResolveConfiguredWorkshopRoot() const;
@@ -110,10 +114,11 @@ public:
     void LoadHooks();
     void GameEndedEvent(std::string name);
     void TryHealCurrentPack(GameWrapper* gw);  // Pack healer helper
+    void RecordShotAttempt();                  // TrainingShotAttempt hook; game thread, no I/O
 
     // Training Pack update integration
     std::filesystem::path GetTrainingPacksPath() const;
-    void UpdateTrainingPackList();
+    void UpdateTrainingPackList(bool fullSync = false);  // Quick sync unless fullSync
     void LoadTrainingPacksFromFile(const std::filesystem::path& filePath);
     bool IsTrainingPackCacheStale() const;
     std::string FormatLastUpdatedTime() const;
@@ -133,6 +138,8 @@ private:
     // Loadout management
     std::unique_ptr<LoadoutManager> loadoutManager;
     std::unique_ptr<PackUsageTracker> usageTracker;
+    std::unique_ptr<ShotStatsTracker> shotStats;  // Declared first: the telemetry writer feeds it
+    std::unique_ptr<ShotTelemetry> shotTelemetry;
     std::shared_ptr<WorkshopDownloader> workshopDownloader;
     std::unique_ptr<TextureDownloader> textureDownloader;
 
@@ -148,4 +155,8 @@ private:
     uintptr_t imgui_ctx = 0;
     std::atomic<bool> isRenderingSettings{false};
     std::thread textureDownloadThread;  // Managed texture download thread
+    std::thread workshopScanThread;     // Managed workshop folder scan
+    std::shared_ptr<bool> workshopAlive = std::make_shared<bool>(true);  // Reset in onUnload; the scan's game-thread callback checks it
+    std::atomic<CatalogLoadState> workshopLoadState{CatalogLoadState::Idle};
+    std::atomic<uint64_t> workshopVersion{0};
 };
\ No newline at end of file
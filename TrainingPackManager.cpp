@@ -2,141 +2,407 @@
 #include "bakkesmod/wrappers/GameEvent/SaveData/TrainingEditorSaveDataWrapper.h"
 #include "pch.h"
 #include "TrainingPackManager.h"
-#include "EmbeddedPackGrabber.h"
+#include "PackCode.h"
+#include "PackDelta.h"
+#include "PackJsonReader.h"
+#include "PackOverlay.h"
+#include "PackScraper.h"
+#include "PackSnapshot.h"
+#include "PackSyncState.h"
 
 #include <algorithm>
+#include <bit>
 #include <chrono>
 #include <fstream>
 #include <iomanip>
+#include <numeric>
 #include <random>
-#include <set>
 #include <sstream>
 #include <thread>
 
-void TrainingPackManager::LoadPacksFromFile(const std::filesystem::path& filePath)
+namespace
 {
-    if (!std::filesystem::exists(filePath)) {
-        LOG("SuiteSpot: Pack cache file not found: {}", filePath.string());
-        {
-            std::lock_guard<std::mutex> lock(packMutex);
-            RLTraining.clear();
-            packCount = 0;
+    // The pack list of a catalog, sharing the catalog's lifetime (aliasing shared_ptr)
+    std::shared_ptr<const std::vector<TrainingEntry>> PacksOf(std::shared_ptr<const PackCatalog> snapshot)
+    {
+        const auto* packs = &snapshot->packs;
+        return { std::move(snapshot), packs };
+    }
+
+    // "ce79f64d344f5f1e" -> "CE79-F64D-344F-5F1E"; codes that don't parse are kept as typed
+    std::string CanonicalCode(const std::string& code)
+    {
+        PackCode parsed;
+        return PackCode::Parse(code, parsed) ? parsed.ToString() : code;
+    }
+
+    // Sort alphabetically by name: fold each name once, then order positions by key
+    void SortPacksByName(std::vector<TrainingEntry>& packs)
+    {
+        std::vector<std::string> nameKeys;
+        nameKeys.reserve(packs.size());
+        for (const auto& entry : packs) {
+            nameKeys.push_back(PackColumns::FoldKey(entry.name));
         }
-        lastUpdated = "Never";
-        return;
+        std::vector<int> order(packs.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+            [&nameKeys](int a, int b) { return nameKeys[a] < nameKeys[b]; });
+
+        std::vector<TrainingEntry> sorted;
+        sorted.reserve(packs.size());
+        for (int index : order) {
+            sorted.push_back(std::move(packs[index]));
+        }
+        packs.swap(sorted);
     }
 
-    try {
+    // What a quick sync compares to decide a scraped pack is "already known". Likes and
+    // plays tick up constantly, so they don't count; they're refreshed on a full sync.
+    bool SameListing(const TrainingEntry& a, const TrainingEntry& b)
+    {
+        return a.name == b.name && a.creator == b.creator && a.creatorSlug == b.creatorSlug &&
+               a.difficulty == b.difficulty && a.tags == b.tags && a.shotCount == b.shotCount &&
+               a.staffComments == b.staffComments && a.notes == b.notes && a.videoUrl == b.videoUrl &&
+               a.status == b.status;
+    }
+
+    // Quick sync: writes the scraped packs over the base by code. Returns how many packs
+    // were new and how many differed. A pack whose only difference is its likes/plays is
+    // left as it is: counting it would rewrite the base file (and merge) on nearly every
+    // quick sync, and the counters are refreshed by the next full sync anyway.
+    std::pair<int, int> UpsertPacks(std::vector<TrainingEntry>& base, std::vector<TrainingEntry>& scraped)
+    {
+        std::unordered_map<std::string, size_t> rowByCode;
+        rowByCode.reserve(base.size());
+        for (size_t row = 0; row < base.size(); ++row) {
+            rowByCode.emplace(base[row].code, row);
+        }
+
+        int added = 0;
+        int changed = 0;
+        for (auto& pack : scraped) {
+            auto it = rowByCode.find(pack.code);
+            if (it == rowByCode.end()) {
+                rowByCode.emplace(pack.code, base.size());
+                base.push_back(std::move(pack));
+                ++added;
+            } else if (TrainingEntry& existing = base[it->second]; !SameListing(existing, pack)) {
+                existing = std::move(pack);
+                ++changed;
+            }
+        }
+        return { added, changed };
+    }
+}
+
+bool TrainingPackManager::MoveUserPacksToOverlay(const std::filesystem::path& filePath, std::vector<TrainingEntry>& packs)
+{
+    const auto isUserPack = [](const TrainingEntry& pack) { return pack.source == "custom" || pack.isModified; };
+    std::vector<PackOverlay::Op> ops;
+    for (const auto& pack : packs) {
+        if (isUserPack(pack)) {
+            ops.push_back(PackOverlay::Op::Upsert(pack));
+        }
+    }
+    if (ops.empty()) return false;
+
+    // Overlay first: if the rewrite below fails or is cut short, the packs are in both
+    // files, and moving them again next time is harmless (an upsert sets the whole pack)
+    if (!PackOverlay::Prepend(filePath, ops)) {
+        LOG("SuiteSpot: Could not move {} custom/edited pack(s) into the overlay; a pack update may drop them", ops.size());
+        return false;
+    }
+    packs.erase(std::remove_if(packs.begin(), packs.end(), isUserPack), packs.end());
+
+    std::string source = PackSyncState::Read(filePath).source;
+    if (source.empty()) {
+        source = PackScraper::kDefaultSourceUrl;
+    }
+    if (!PackJsonReader::WriteFile(filePath, packs, source)) {
+        LOG("SuiteSpot: Could not rewrite {} without its custom/edited packs; the overlay copies take precedence", filePath.string());
+    }
+    LOG("SuiteSpot: Moved {} custom/edited pack(s) from the pack file into the overlay", ops.size());
+    return true;
+}
+
+void TrainingPackManager::Publish(std::shared_ptr<PackCatalog> next)
+{
+    next->version = ++lastVersion;
+    catalog.store(std::move(next));
+}
+
+void TrainingPackManager::JournalEdits(const std::vector<PackOverlay::Op>& ops)
+{
+    if (openCaptures > 0) {
+        editJournal.insert(editJournal.end(), ops.begin(), ops.end());
+    }
+}
+
+TrainingPackManager::EditCapture::EditCapture(TrainingPackManager& manager)
+    : owner(manager)
+{
+    std::lock_guard<std::mutex> lock(owner.writeMutex);
+    start = owner.journalStart + owner.editJournal.size();
+    ++owner.openCaptures;
+}
+
+TrainingPackManager::EditCapture::~EditCapture()
+{
+    if (active) {
+        std::lock_guard<std::mutex> lock(owner.writeMutex);
+        Take();
+    }
+}
+
+std::vector<PackOverlay::Op> TrainingPackManager::EditCapture::Take()
+{
+    std::vector<PackOverlay::Op> ops;
+    if (!active) return ops;
+    active = false;
+
+    ops.assign(owner.editJournal.begin() + static_cast<ptrdiff_t>(start - owner.journalStart),
+               owner.editJournal.end());
+    if (--owner.openCaptures == 0) {
+        owner.journalStart += owner.editJournal.size();
+        owner.editJournal.clear();
+    }
+    return ops;
+}
+
+TrainingPackManager::~TrainingPackManager()
+{
+    // The updater's merge waits on the heal flusher, so stop it before the flusher
+    CancelUpdate();
+    WaitForUpdate();
+    WaitForLoad();
+    FlushPendingHeals();
+}
+
+bool TrainingPackManager::ReadBaseFile(const std::filesystem::path& filePath, std::vector<TrainingEntry>& packs,
+                                       bool reportProgress)
+{
+    std::lock_guard<std::mutex> lock(baseFileMutex);
+    return ReadBaseFileLocked(filePath, packs, reportProgress);
+}
+
+bool TrainingPackManager::ReadBaseFileLocked(const std::filesystem::path& filePath, std::vector<TrainingEntry>& packs,
+                                             bool reportProgress)
+{
+    // The binary snapshot is already name-sorted; only fall back to the JSON if it's
+    // missing, stale or damaged, and then write a fresh one for next time.
+    // No base file yet just means an empty base; custom packs in the overlay still load.
+    bool writeSnapshot = false;
+    if (!std::filesystem::exists(filePath)) {
+        LOG("SuiteSpot: Pack cache file not found: {}", filePath.string());
+    } else if (PackSnapshot::Read(filePath, packs)) {
+        LOG("SuiteSpot: Loaded training packs from snapshot");
+    } else {
         std::ifstream file(filePath);
         if (!file.is_open()) {
             LOG("SuiteSpot: Failed to open Pack cache file");
-            return;
+            return false;
         }
 
-        nlohmann::json jsonData;
-        file >> jsonData;
+        // Streams packs out of the file without building a JSON tree; logs its own errors.
+        // Parsing is most of the work, so it gets most of the progress bar.
+        std::function<void(float)> onProgress;
+        if (reportProgress) {
+            onProgress = [this](float fraction) { loadProgress = fraction * 0.8f; };
+        }
+        const bool parsed = PackJsonReader::Read(file, packs, onProgress);
+        if (!parsed) {
+            return false;
+        }
         file.close();
 
-        std::lock_guard<std::mutex> lock(packMutex);
-        RLTraining.clear();
+        SortPacksByName(packs);
+        writeSnapshot = true;
+    }
 
-        if (!jsonData.contains("packs") || !jsonData["packs"].is_array()) {
-            LOG("SuiteSpot: Invalid Pack cache file format - missing 'packs' array");
-            return;
+    // Older versions kept custom and edited packs in this file, which a sync rewrites
+    if (MoveUserPacksToOverlay(filePath, packs)) {
+        writeSnapshot = true;
+    }
+    if (writeSnapshot) {
+        PackSnapshot::Write(filePath, packs);
+    }
+    migratedBasePath = filePath;
+    return true;
+}
+
+bool TrainingPackManager::WriteBaseFile(const std::filesystem::path& filePath, const std::vector<TrainingEntry>& packs,
+                                        const std::string& sourceUrl)
+{
+    std::lock_guard<std::mutex> lock(baseFileMutex);
+
+    // A full sync can finish before the file it replaces was ever read (and had its custom
+    // packs moved out); read it now so none are lost
+    if (migratedBasePath != filePath && std::filesystem::exists(filePath)) {
+        std::vector<TrainingEntry> old;
+        if (!ReadBaseFileLocked(filePath, old, false)) {
+            LOG("SuiteSpot: Not replacing a pack file that could not be read: {}", filePath.string());
+            return false;
         }
+    }
+    return PackJsonReader::WriteFile(filePath, packs, sourceUrl);
+}
 
-        for (const auto& pack : jsonData["packs"]) {
-            TrainingEntry entry;
+bool TrainingPackManager::ReadPackFile(const std::filesystem::path& filePath, std::vector<TrainingEntry>& packs,
+                                       bool reportProgress)
+{
+    if (!ReadBaseFile(filePath, packs, reportProgress)) {
+        return false;
+    }
+    if (reportProgress) loadProgress = 0.85f;
 
-            if (pack.contains("code") && pack["code"].is_string()) {
-                entry.code = pack["code"].get<std::string>();
-            }
-            if (pack.contains("name") && pack["name"].is_string()) {
-                entry.name = pack["name"].get<std::string>();
-            }
+    // User changes live in the overlay, on top of the (untouched) scraped base
+    if (PackOverlay::Apply(filePath, packs).needsSort) {
+        SortPacksByName(packs);
+    }
+    if (reportProgress) loadProgress = 0.9f;
+    return true;
+}
 
-            if (entry.code.empty() || entry.name.empty()) {
-                continue;
-            }
+void TrainingPackManager::LoadPacksFromFile(const std::filesystem::path& filePath)
+{
+    loadProgress = 0.0f;
+    loadState = CatalogLoadState::Loading;
+    {
+        // Known up front so edits made while this load runs still land in the right overlay
+        std::lock_guard<std::mutex> lock(writeMutex);
+        currentFilePath = filePath;
+    }
 
-            if (pack.contains("creator") && pack["creator"].is_string()) {
-                entry.creator = pack["creator"].get<std::string>();
-            }
-            if (pack.contains("creatorSlug") && pack["creatorSlug"].is_string()) {
-                entry.creatorSlug = pack["creatorSlug"].get<std::string>();
-            }
-            if (pack.contains("difficulty") && pack["difficulty"].is_string()) {
-                entry.difficulty = pack["difficulty"].get<std::string>();
-            }
-            if (pack.contains("shotCount") && pack["shotCount"].is_number()) {
-                entry.shotCount = pack["shotCount"].get<int>();
-            }
-            if (pack.contains("staffComments") && pack["staffComments"].is_string()) {
-                entry.staffComments = pack["staffComments"].get<std::string>();
-            }
-            if (pack.contains("notes") && pack["notes"].is_string()) {
-                entry.notes = pack["notes"].get<std::string>();
-            }
-            if (pack.contains("videoUrl") && pack["videoUrl"].is_string()) {
-                entry.videoUrl = pack["videoUrl"].get<std::string>();
-            }
-            if (pack.contains("likes") && pack["likes"].is_number()) {
-                entry.likes = pack["likes"].get<int>();
-            }
-            if (pack.contains("plays") && pack["plays"].is_number()) {
-                entry.plays = pack["plays"].get<int>();
-            }
-            if (pack.contains("status") && pack["status"].is_number()) {
-                entry.status = pack["status"].get<int>();
-            }
+    try {
+        // Edits from here on are replayed on what's read. Heals queued before this point
+        // are only in memory, so get them into the overlay before reading it.
+        EditCapture edits(*this);
+        WaitForQueuedHeals();
+
+        // Build the new catalog off to the side; readers keep the old one until the swap
+        auto next = std::make_shared<PackCatalog>();
+        if (!ReadPackFile(filePath, next->packs, true)) {
+            loadState = CatalogLoadState::Failed;
+            return;
+        }
 
-            if (pack.contains("tags") && pack["tags"].is_array()) {
-                for (const auto& tag : pack["tags"]) {
-                    if (tag.is_string()) {
-                        entry.tags.push_back(tag.get<std::string>());
-                    }
+        // Indexes are built here on the worker too; publishing is only the pointer swap
+        next->BuildIndexes();
+        next->lastUpdated = GetLastUpdatedTime(filePath);
+        size_t loaded = 0;
+        {
+            std::lock_guard<std::mutex> lock(writeMutex);
+            auto missed = edits.Take();
+            if (!missed.empty()) {
+                // Rare (an edit during the read), so rebuilding the indexes here is fine
+                if (PackOverlay::ApplyOps(std::move(missed), next->packs).needsSort) {
+                    SortPacksByName(next->packs);
                 }
+                next->BuildIndexes();
+                LOG("SuiteSpot: Replayed edits made while the pack list was loading");
             }
-
-            // Unified system fields
-            if (pack.contains("source") && pack["source"].is_string()) {
-                entry.source = pack["source"].get<std::string>();
-            } else {
-                entry.source = "prejump"; // Default for backward compatibility
-            }
-            
-            // Bag categories removed - skip loading bagCategories and orderInBag
-            
-            if (pack.contains("isModified") && pack["isModified"].is_boolean()) {
-                entry.isModified = pack["isModified"].get<bool>();
-            }
-
-            RLTraining.push_back(entry);
+            loaded = next->packs.size();
+            Publish(std::move(next));
         }
 
-        // Sort RLTraining alphabetically by name
-        std::sort(RLTraining.begin(), RLTraining.end(), [](const TrainingEntry& a, const TrainingEntry& b) {
-            // Case-insensitive comparison for names
-            std::string nameA = a.name;
-            std::string nameB = b.name;
-            std::transform(nameA.begin(), nameA.end(), nameA.begin(), [](unsigned char c) { return std::tolower(c); });
-            std::transform(nameB.begin(), nameB.end(), nameB.begin(), [](unsigned char c) { return std::tolower(c); });
-            return nameA < nameB;
-        });
-
-        packCount = static_cast<int>(RLTraining.size());
-        lastUpdated = GetLastUpdatedTime(filePath);
-        currentFilePath = filePath;
-
-        LOG("SuiteSpot: Loaded {} training packs from file", packCount);
+        loadProgress = 1.0f;
+        loadState = CatalogLoadState::Ready;
+        LOG("SuiteSpot: Loaded {} training packs from file", loaded);
 
     } catch (const std::exception& e) {
+        // Nothing is published: readers keep the last catalog, as Failed promises
         LOG("SuiteSpot: Error loading training packs: {}", std::string(e.what()));
+        loadState = CatalogLoadState::Failed;
+    }
+}
+
+bool TrainingPackManager::MergePacksFromFile(const std::filesystem::path& filePath)
+{
+    try {
+        // Edits from here on are replayed on the scrape before diffing. Heals still waiting in
+        // the queue aren't in the overlay yet; without the wait the merge would see the scraped
+        // shot count as a change and undo them.
+        EditCapture edits(*this);
+        WaitForQueuedHeals();
+
+        // Read the scrape exactly as a full load would, user overlay included, but off to the side
+        std::vector<TrainingEntry> scraped;
+        if (!ReadPackFile(filePath, scraped, false)) {
+            LOG("SuiteSpot: Keeping the current catalog; the updated pack file could not be read");
+            return false;
+        }
+        const std::string updated = GetLastUpdatedTime(filePath);
+
+        auto delta = std::make_shared<PackDelta>();
         {
-            std::lock_guard<std::mutex> lock(packMutex);
-            RLTraining.clear();
-            packCount = 0;
+            // Diff and patch under the writer lock so no edit made meanwhile is lost
+            std::lock_guard<std::mutex> lock(writeMutex);
+            currentFilePath = filePath;
+            auto missed = edits.Take();
+            if (!missed.empty()) {
+                // Otherwise the diff would see the edit as something the scrape undid
+                if (PackOverlay::ApplyOps(std::move(missed), scraped).needsSort) {
+                    SortPacksByName(scraped);
+                }
+                LOG("SuiteSpot: Replayed edits made while the pack update was being read");
+            }
+            const auto current = GetCatalog();
+            *delta = PackDelta::Compute(*current, scraped);
+
+            std::shared_ptr<PackCatalog> next;
+            if (delta->IsLarge(current->packs.size())) {
+                // Most of the catalog changed (or there wasn't one): the scrape already is the result
+                next = std::make_shared<PackCatalog>();
+                next->packs = std::move(scraped);
+                next->BuildIndexes();
+            } else {
+                next = std::make_shared<PackCatalog>(*current);
+                delta->ApplyTo(*next);
+            }
+            next->lastUpdated = updated;
+            Publish(std::move(next));
+            delta->version = lastVersion;
         }
+
+        LOG("SuiteSpot: Pack update merged: {} added, {} changed, {} removed",
+            delta->added.size(), delta->changed.size(), delta->removed.size());
+        lastDelta.store(std::move(delta));
+        return true;
+
+    } catch (const std::exception& e) {
+        LOG("SuiteSpot: Error merging updated training packs: {}", std::string(e.what()));
+        return false;
+    }
+}
+
+std::shared_ptr<const PackDelta> TrainingPackManager::GetLastDelta() const
+{
+    return lastDelta.load();
+}
+
+void TrainingPackManager::LoadPacksAsync(const std::filesystem::path& filePath)
+{
+    if (loadState == CatalogLoadState::Loading) {
+        LOG("SuiteSpot: Training pack load already in progress");
+        return;
+    }
+
+    // The previous worker has finished (state isn't Loading), so this join is immediate
+    WaitForLoad();
+
+    // Set here too so the UI shows "Loading" from this frame on, not from when the thread starts
+    loadProgress = 0.0f;
+    loadState = CatalogLoadState::Loading;
+    loadThread = std::thread([this, filePath]() {
+        LoadPacksFromFile(filePath);
+    });
+}
+
+void TrainingPackManager::WaitForLoad()
+{
+    if (loadThread.joinable()) {
+        loadThread.join();
     }
 }
 
@@ -146,15 +412,13 @@ bool TrainingPackManager::IsCacheStale(const std::filesystem::path& filePath) co
         return true;
     }
 
-    try {
-        auto lastWriteTime = std::filesystem::last_write_time(filePath);
-        auto now = std::filesystem::file_time_type::clock::now();
-        auto age = std::chrono::duration_cast<std::chrono::hours>(now - lastWriteTime);
-
-        return age.count() > 168;
-    } catch (...) {
+    // Counts from the last update of either kind; a quick sync refreshes the list too
+    const auto state = PackSyncState::Read(filePath);
+    if (state.lastSync == 0) {
         return true;
     }
+    const auto age = std::chrono::system_clock::now() - std::chrono::system_clock::from_time_t(state.lastSync);
+    return std::chrono::duration_cast<std::chrono::hours>(age).count() > 168;
 }
 
 std::string TrainingPackManager::GetLastUpdatedTime(const std::filesystem::path& filePath) const
@@ -179,421 +443,364 @@ std::string TrainingPackManager::GetLastUpdatedTime(const std::filesystem::path&
 }
 
 void TrainingPackManager::UpdateTrainingPackList(const std::filesystem::path& outputPath,
-                                                   const std::shared_ptr<GameWrapper>& gameWrapper)
+                                                   const std::shared_ptr<GameWrapper>& gameWrapper,
+                                                   const std::string& sourceUrl,
+                                                   bool fullSync)
 {
-    if (scrapingInProgress) {
-        LOG("SuiteSpot: Training pack update already in progress");
+    if (!gameWrapper && !httpGet) {
+        LOG("SuiteSpot: GameWrapper unavailable for training pack update");
         return;
     }
 
-    if (!gameWrapper) {
-        LOG("SuiteSpot: GameWrapper unavailable for training pack update");
+    if (scrapingInProgress.exchange(true)) {
+        LOG("SuiteSpot: Training pack update already in progress");
         return;
     }
 
-    scrapingInProgress = true;
-
     LOG("SuiteSpot: Training pack updater starting");
     LOG("SuiteSpot: Output path: {}", outputPath.string());
 
+    // The previous updater has finished (scrapingInProgress was clear), so this join is immediate
+    WaitForUpdate();
+    cancelUpdate = false;
+    {
+        std::lock_guard<std::mutex> lock(updateStatusMutex);
+        updateStatus = PackUpdateStatus{ PackUpdateState::Fetching, {} };
+    }
+
     // Launch update in background thread to avoid blocking game thread
-    std::thread updateThread([this, outputPath]() {
+    updateThread = std::thread([this, outputPath, sourceUrl, fullSync, get = httpGet]() {
+        auto setState = [this](PackUpdateState state) {
+            std::lock_guard<std::mutex> lock(updateStatusMutex);
+            updateStatus.state = state;
+        };
+
         try {
-            // Get temp directory for script extraction
-            std::filesystem::path tempDir = std::filesystem::temp_directory_path();
-            auto tempScript = tempDir / "SuitePackGrabber_temp.ps1";
-            auto logFile = outputPath.parent_path() / "PackGrabber.log";
-
-            // Write embedded script to temp file
-            {
-                std::ofstream tempFile(tempScript, std::ios::binary);
-                if (!tempFile.is_open()) {
-                    LOG("SuiteSpot: Failed to create temp script file: {}", tempScript.string());
-                    scrapingInProgress = false;
-                    return;
+            PackScraper::Options options;
+            options.baseUrl = sourceUrl.empty() ? PackScraper::kDefaultSourceUrl : sourceUrl;
+
+            // A quick sync only adds to the pack file, so that file has to be a complete
+            // download from this source in the current layout
+            PackSyncState::State state = PackSyncState::Read(outputPath);
+            std::vector<TrainingEntry> base;
+            const bool quick = !fullSync && !state.NeedsFullSync(options.baseUrl) &&
+                             std::filesystem::exists(outputPath) && ReadBaseFile(outputPath, base, false);
+
+            std::unordered_map<std::string, const TrainingEntry*> known;
+            if (quick) {
+                known.reserve(base.size());
+                for (const auto& pack : base) {
+                    known.emplace(pack.code, &pack);
                 }
-                tempFile.write(EMBEDDED_PACK_GRABBER_SCRIPT,
-                              std::string_view(EMBEDDED_PACK_GRABBER_SCRIPT).length());
-                tempFile.close();
+                options.isKnown = [&known](const TrainingEntry& pack) {
+                    auto it = known.find(pack.code);
+                    return it != known.end() && SameListing(*it->second, pack);
+                };
+                options.ifModifiedSince = PackSyncState::HttpDate(state.lastSync);
             }
-
-            std::string outStr = outputPath.string();
-
-            // Use cmd.exe to launch PowerShell and capture output to log file
-            std::string cmd = "cmd.exe /c powershell.exe -NoProfile -ExecutionPolicy Bypass -File \""
-                            + tempScript.string() + "\" -OutputPath \"" + outStr + "\" > \"" + logFile.string() + "\" 2>&1";
-
-            LOG("SuiteSpot: Training pack updater started");
-
-            int result = system(cmd.c_str());
-
-            LOG("SuiteSpot: Training pack updater returned: {}", result);
-
-            // Try to read error log if it exists
-            if (std::filesystem::exists(logFile)) {
-                std::ifstream log(logFile);
-                std::string line;
-                LOG("SuiteSpot: PackGrabber output:");
-                while (std::getline(log, line)) {
-                    LOG("  {}", line);
+            options.cancel = &cancelUpdate;
+            options.onProgress = [this](const PackScraper::Progress& progress) {
+                std::lock_guard<std::mutex> lock(updateStatusMutex);
+                updateStatus.progress = progress;
+            };
+            LOG("SuiteSpot: Training pack updater started ({} sync, {})", quick ? "quick" : "full", options.baseUrl);
+
+            PackScraper::Result result = PackScraper::Run(options, get);
+            const std::time_t now = std::time(nullptr);
+            if (result.cancelled) {
+                setState(PackUpdateState::Cancelled);
+            } else if (!result.Complete()) {
+                // Missing pages would look like deleted packs to the merge
+                setState(PackUpdateState::Failed);
+                LOG("SuiteSpot: Training pack update incomplete ({} of {} pages failed); keeping the current list",
+                    result.failedPages.size(), result.pageCount);
+            } else if (quick) {
+                setState(PackUpdateState::Merging);
+                known.clear();  // Points into base, which the upsert changes
+                const auto [added, changed] = result.notModified ? std::pair<int, int>{} : UpsertPacks(base, result.packs);
+                if (added + changed == 0) {
+                    LOG("SuiteSpot: Training pack list already up to date ({} request(s))",
+                        result.notModified ? 1 : result.pagesFetched);
+                    state.lastSync = now;
+                    PackSyncState::Write(outputPath, state);
+                    setState(PackUpdateState::Done);
+                } else if (WriteBaseFile(outputPath, base, options.baseUrl)) {
+                    LOG("SuiteSpot: Quick sync found {} new and {} changed packs in {} page(s)",
+                        added, changed, result.pagesFetched);
+                    state.lastSync = now;
+                    PackSyncState::Write(outputPath, state);
+                    setState(MergePacksFromFile(outputPath) ? PackUpdateState::Done : PackUpdateState::Failed);
+                } else {
+                    LOG("SuiteSpot: Failed to write updated pack file: {}", outputPath.string());
+                    setState(PackUpdateState::Failed);
                 }
-            }
-
-            if (result == 0) {
-                LOG("SuiteSpot: Training pack update completed successfully");
-                LoadPacksFromFile(outputPath);
-                lastUpdated = GetLastUpdatedTime(outputPath);
+            } else if (result.packs.empty()) {
+                LOG("SuiteSpot: Training pack update returned no packs; keeping the current list");
+                setState(PackUpdateState::Failed);
             } else {
-                LOG("SuiteSpot: Training pack updater returned non-zero exit code: {}", result);
-            }
-
-            // Clean up temp script
-            try {
-                if (std::filesystem::exists(tempScript)) {
-                    std::filesystem::remove(tempScript);
-                    LOG("SuiteSpot: Cleaned up temporary script file");
+                setState(PackUpdateState::Merging);
+                if (WriteBaseFile(outputPath, result.packs, options.baseUrl)) {
+                    LOG("SuiteSpot: Training pack update completed successfully");
+                    state.format = PackSyncState::kFormat;
+                    state.source = options.baseUrl;
+                    state.lastSync = now;
+                    state.lastFullSync = now;
+                    PackSyncState::Write(outputPath, state);
+                    setState(MergePacksFromFile(outputPath) ? PackUpdateState::Done : PackUpdateState::Failed);
+                } else {
+                    LOG("SuiteSpot: Failed to write updated pack file: {}", outputPath.string());
+                    setState(PackUpdateState::Failed);
                 }
-            } catch (const std::exception& e) {
-                LOG("SuiteSpot: Warning - failed to clean up temp script: {}", std::string(e.what()));
             }
 
         } catch (const std::exception& e) {
             LOG("SuiteSpot: Training pack updater error: {}", std::string(e.what()));
+            setState(PackUpdateState::Failed);
         }
 
         scrapingInProgress = false;
     });
+}
+
+void TrainingPackManager::CancelUpdate()
+{
+    if (scrapingInProgress) {
+        LOG("SuiteSpot: Cancelling training pack update");
+        cancelUpdate = true;
+    }
+}
 
-    updateThread.detach();  // Let thread run independently
+void TrainingPackManager::WaitForUpdate()
+{
+    if (updateThread.joinable()) {
+        updateThread.join();
+    }
+}
+
+PackUpdateStatus TrainingPackManager::GetUpdateStatus() const
+{
+    std::lock_guard<std::mutex> lock(updateStatusMutex);
+    return updateStatus;
 }
 
 void TrainingPackManager::FilterAndSortPacks(const std::string& searchText,
                                             const std::string& difficultyFilter,
-                                            const std::string& tagFilter,
+                                            const std::vector<std::string>& tagFilters,
+                                            bool matchAllTags,
                                             int minShots,
                                             bool videoFilter,
                                             int sortColumn,
                                             bool sortAscending,
-                                            std::vector<TrainingEntry>& out) const
+                                            int secondarySortColumn,
+                                            bool secondaryAscending,
+                                            PackResultView& out,
+                                            PackFacetCounts* outFacets) const
 {
-    std::lock_guard<std::mutex> lock(packMutex);
-    out.clear();
-
-    std::string searchLower(searchText);
-    std::transform(searchLower.begin(), searchLower.end(), searchLower.begin(),
-        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
-
-    for (const auto& pack : RLTraining) {
-        // Video filter - skip packs without video if filter is enabled
-        if (videoFilter && pack.videoUrl.empty()) {
-            continue;
+    // Pinned, not locked: the whole filter and sort runs against this one version
+    const auto snapshot = GetCatalog();
+    out.packs = PacksOf(snapshot);
+    out.rows.clear();
+    const auto& packs = snapshot->packs;
+    const auto& searchIndex = snapshot->searchIndex;
+    const auto& columns = snapshot->columns;
+    const auto& sortIndex = snapshot->sortIndex;
+
+    // Every filter narrows one bitmap of candidate rows. Name/code search comes from the
+    // trigram index; difficulty, tags and video are precomputed facet bitmaps.
+    PackBitmap matches(packs.size(), searchText.empty());
+    if (!searchText.empty()) {
+        std::vector<int> found;
+        searchIndex.Find(searchText, found);
+        for (int row : found) {
+            matches.Set(row);
         }
+    }
 
-        if (!searchLower.empty()) {
-            // Search only by NAME or CODE
-            bool matchesSearch = false;
-
-            // 1. Search by name (case-insensitive, partial match)
-            std::string nameLower = pack.name;
-            std::transform(nameLower.begin(), nameLower.end(), nameLower.begin(),
-                [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
-            if (nameLower.find(searchLower) != std::string::npos) {
-                matchesSearch = true;
-            }
+    if (videoFilter) {
+        matches &= columns.hasVideo;
+    }
 
-            // 2. Search by code (supports both formatted "XXXX-XXXX-XXXX-XXXX" and unformatted 16-char)
-            if (!matchesSearch) {
-                // Remove all dashes from both search term and pack code for comparison
-                std::string codeLower = pack.code;
-                std::string searchNoDashes = searchLower;
-                std::transform(codeLower.begin(), codeLower.end(), codeLower.begin(),
-                    [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
-                
-                // Strip dashes from both strings
-                codeLower.erase(std::remove(codeLower.begin(), codeLower.end(), '-'), codeLower.end());
-                searchNoDashes.erase(std::remove(searchNoDashes.begin(), searchNoDashes.end(), '-'), searchNoDashes.end());
-                
-                // Match if search term is contained in code (allows partial code search)
-                if (codeLower.find(searchNoDashes) != std::string::npos) {
-                    matchesSearch = true;
-                }
+    // Shot count is a range, so it's checked against the column for rows still standing
+    if (minShots > 0) {
+        const int32_t* shotCol = columns.shots.data();
+        std::vector<uint64_t>& words = matches.Words();
+        for (size_t w = 0; w < words.size(); ++w) {
+            uint64_t keep = 0;
+            for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+                const int bit = std::countr_zero(bits);
+                keep |= static_cast<uint64_t>(shotCol[w * 64 + bit] >= minShots) << bit;
             }
+            words[w] = keep;
+        }
+    }
 
-            if (!matchesSearch) {
+    // Rank 0 already holds every "no difficulty" value (empty, Unknown, All, Unranked)
+    const bool anyDifficulty = (difficultyFilter == "All");
+    const PackBitmap* difficultyMatches = anyDifficulty
+        ? nullptr : &columns.difficultyBits[PackColumns::DifficultyRank(difficultyFilter)];
+
+    PackBitmap tagMatches;
+    if (!tagFilters.empty()) {
+        tagMatches.Reset(packs.size(), matchAllTags);
+        for (const auto& tag : tagFilters) {
+            const int tagId = columns.FindTagId(tag);
+            if (tagId == PackColumns::kNoTag) {
+                // Nobody has this tag: fails every row for AND, adds nothing for OR
+                if (matchAllTags) tagMatches.Reset(packs.size());
                 continue;
             }
-        }
-
-        if (difficultyFilter != "All") {
-            if (difficultyFilter == "Unranked") {
-                // Match "Unranked" filter against all "no difficulty" values
-                if (!pack.difficulty.empty() && pack.difficulty != "Unknown" && pack.difficulty != "All" && pack.difficulty != "Unranked") {
-                    continue;
-                }
+            if (matchAllTags) {
+                tagMatches &= columns.tagBits[tagId];
             } else {
-                // Standard strict match for ranked tiers
-                if (pack.difficulty != difficultyFilter) {
-                    continue;
-                }
-            }
-        }
-
-        if (!tagFilter.empty()) {
-            bool hasTag = false;
-            for (const auto& tag : pack.tags) {
-                if (tag == tagFilter) {
-                    hasTag = true;
-                    break;
-                }
+                tagMatches |= columns.tagBits[tagId];
             }
-            if (!hasTag) continue;
         }
+    }
 
-        if (pack.shotCount < minShots) {
-            continue;
+    // Facet counts: each facet is counted against every *other* active filter, so the
+    // numbers say what picking that option would return. All popcounts, no extra queries.
+    if (outFacets) {
+        PackBitmap forDifficulty = matches;
+        if (!tagFilters.empty()) forDifficulty &= tagMatches;
+        outFacets->anyDifficulty = static_cast<int>(forDifficulty.Count());
+        for (int rank = 0; rank < PackColumns::kDifficultyRanks; ++rank) {
+            outFacets->byDifficultyRank[rank] = static_cast<int>(forDifficulty.CountAnd(columns.difficultyBits[rank]));
         }
 
-        out.push_back(pack);
-    }
-
-    // Case-insensitive string comparison helper
-    auto caseInsensitiveCompare = [](const std::string& a, const std::string& b) -> int {
-        std::string lowerA = a;
-        std::string lowerB = b;
-        std::transform(lowerA.begin(), lowerA.end(), lowerA.begin(), [](unsigned char c) { return std::tolower(c); });
-        std::transform(lowerB.begin(), lowerB.end(), lowerB.begin(), [](unsigned char c) { return std::tolower(c); });
-        return lowerA.compare(lowerB);
-    };
-
-    // Difficulty ranking helper (lower rank = easier)
-    auto getDifficultyRank = [](const std::string& difficulty) -> int {
-        std::string diffLower = difficulty;
-        std::transform(diffLower.begin(), diffLower.end(), diffLower.begin(), [](unsigned char c) { return std::tolower(c); });
-        
-        if (diffLower.empty() || diffLower == "unknown" || diffLower == "all" || diffLower == "unranked") return 0;
-        if (diffLower == "bronze") return 1;
-        if (diffLower == "silver") return 2;
-        if (diffLower == "gold") return 3;
-        if (diffLower == "platinum") return 4;
-        if (diffLower == "diamond") return 5;
-        if (diffLower == "champion") return 6;
-        if (diffLower == "grand champion") return 7;
-        if (diffLower == "supersonic legend") return 8;
-        return 0; // Unknown difficulties default to unranked
-    };
-
-    std::sort(out.begin(), out.end(), [sortColumn, sortAscending, &caseInsensitiveCompare, &getDifficultyRank](const TrainingEntry& a, const TrainingEntry& b) {
-        int cmp = 0;
-        switch (sortColumn) {
-            case 0: // Name
-                cmp = caseInsensitiveCompare(a.name, b.name);
-                break;
-            case 1: // Creator
-                cmp = caseInsensitiveCompare(a.creator, b.creator);
-                break;
-            case 2: // Difficulty
-                {
-                    int rankA = getDifficultyRank(a.difficulty);
-                    int rankB = getDifficultyRank(b.difficulty);
-                    cmp = (rankA < rankB) ? -1 : (rankA > rankB) ? 1 : 0;
-                }
-                break;
-            case 3: // Shots
-                cmp = (a.shotCount < b.shotCount) ? -1 : (a.shotCount > b.shotCount) ? 1 : 0;
-                break;
-            case 4: // Likes
-                cmp = (a.likes < b.likes) ? -1 : (a.likes > b.likes) ? 1 : 0;
-                break;
-            case 5: // Plays
-                cmp = (a.plays < b.plays) ? -1 : (a.plays > b.plays) ? 1 : 0;
-                break;
+        // In AND mode each extra tag narrows the current selection; in OR mode tags are alternatives
+        PackBitmap forTags = matches;
+        if (difficultyMatches) forTags &= *difficultyMatches;
+        if (matchAllTags && !tagFilters.empty()) forTags &= tagMatches;
+        outFacets->byTag.clear();
+        for (size_t id = 0; id < columns.tagNames.size(); ++id) {
+            outFacets->byTag[columns.tagNames[id]] = static_cast<int>(forTags.CountAnd(columns.tagBits[id]));
         }
-        return sortAscending ? (cmp < 0) : (cmp > 0);
-    });
-}
+    }
 
-void TrainingPackManager::BuildAvailableTags(std::vector<std::string>& out) const
-{
-    std::lock_guard<std::mutex> lock(packMutex);
-    std::set<std::string> uniqueTags;
-    for (const auto& pack : RLTraining) {
-        for (const auto& tag : pack.tags) {
-            uniqueTags.insert(tag);
-        }
+    if (difficultyMatches) matches &= *difficultyMatches;
+    if (!tagFilters.empty()) matches &= tagMatches;
+    if (outFacets) {
+        outFacets->total = static_cast<int>(matches.Count());
     }
 
-    out.clear();
-    out.push_back("All Tags");
-    for (const auto& tag : uniqueTags) {
-        out.push_back(tag);
+    // Sort the row numbers, not the packs: walk the pre-sorted order for the column and
+    // keep the rows that survived the filters
+    if (secondarySortColumn >= 0 && secondarySortColumn != sortColumn) {
+        sortIndex.CollectTwoKey(sortColumn, sortAscending, secondarySortColumn, secondaryAscending, matches, out.rows);
+    } else {
+        sortIndex.Collect(sortColumn, sortAscending, matches, out.rows);
     }
 }
 
-void TrainingPackManager::SavePacksToFile(const std::filesystem::path& filePath)
+void TrainingPackManager::BuildAvailableTags(std::vector<std::string>& out) const
 {
-    try {
-        std::lock_guard<std::mutex> lock(packMutex);
-        nlohmann::json output;
-        output["version"] = "1.0.0";
-
-        // Get current time in ISO format
-        auto now = std::chrono::system_clock::now();
-        auto tt = std::chrono::system_clock::to_time_t(now);
-        std::ostringstream oss;
-        oss << std::put_time(std::gmtime(&tt), "%Y-%m-%dT%H:%M:%SZ");
-        output["lastUpdated"] = oss.str();
-
-        output["source"] = "https://prejump.com/training-packs";
-        output["totalPacks"] = RLTraining.size();
-
-        nlohmann::json packsArray = nlohmann::json::array();
-        for (const auto& pack : RLTraining) {
-            nlohmann::json p;
-            p["name"] = pack.name;
-            p["code"] = pack.code;
-            p["creator"] = pack.creator;
-            p["creatorSlug"] = pack.creatorSlug;
-            p["difficulty"] = pack.difficulty;
-            p["shotCount"] = pack.shotCount;
-            p["tags"] = pack.tags;
-            p["videoUrl"] = pack.videoUrl;
-            p["staffComments"] = pack.staffComments;
-            p["notes"] = pack.notes;
-            p["likes"] = pack.likes;
-            p["plays"] = pack.plays;
-            p["status"] = pack.status;
-
-            // Unified system fields
-            p["source"] = pack.source;
-            // Bag categories removed - don't save bagCategories or orderInBag
-            p["isModified"] = pack.isModified;
-
-            packsArray.push_back(p);
-        }
-        output["packs"] = packsArray;
-
-        // Ensure directory exists
-        auto parentDir = filePath.parent_path();
-        if (!std::filesystem::exists(parentDir)) {
-            std::filesystem::create_directories(parentDir);
-        }
-
-        std::ofstream file(filePath);
-        if (!file.is_open()) {
-            LOG("SuiteSpot: Failed to open file for writing: {}", filePath.string());
-            return;
+    out.clear();
+    out.push_back("All Tags");
+    // The tag dictionary already holds each distinct tag once; skip ones whose packs are all gone
+    const auto snapshot = GetCatalog();
+    const auto& columns = snapshot->columns;
+    for (size_t id = 0; id < columns.tagNames.size(); ++id) {
+        if (columns.tagBits[id].Count() > 0) {
+            out.push_back(columns.tagNames[id]);
         }
-
-        file << output.dump(2); // Pretty print with 2-space indent
-        file.close();
-
-        currentFilePath = filePath;
-        lastUpdated = GetLastUpdatedTime(filePath);
-        LOG("SuiteSpot: Saved {} packs to file", RLTraining.size());
-
-    } catch (const std::exception& e) {
-        LOG("SuiteSpot: Error saving packs: {}", std::string(e.what()));
     }
+    std::sort(out.begin() + 1, out.end());
 }
 
 bool TrainingPackManager::AddCustomPack(const TrainingEntry& pack)
 {
+    TrainingEntry newPack = pack;
+    newPack.code = CanonicalCode(pack.code);
+    newPack.source = "custom";
+
     {
-        std::lock_guard<std::mutex> lock(packMutex);
+        std::lock_guard<std::mutex> lock(writeMutex);
+        const auto current = GetCatalog();
         // Check for duplicate code
-        for (const auto& existing : RLTraining) {
-            if (existing.code == pack.code) {
-                LOG("SuiteSpot: Pack with code {} already exists", pack.code);
-                return false;
-            }
+        if (current->codeIndex.Find(newPack.code) != PackCodeIndex::kNotFound) {
+            LOG("SuiteSpot: Pack with code {} already exists", newPack.code);
+            return false;
         }
 
-        TrainingEntry newPack = pack;
-        newPack.source = "custom";
-        RLTraining.push_back(newPack);
-
-        // Sort RLTraining alphabetically by name
-        std::sort(RLTraining.begin(), RLTraining.end(), [](const TrainingEntry& a, const TrainingEntry& b) {
-            std::string nameA = a.name;
-            std::string nameB = b.name;
-            std::transform(nameA.begin(), nameA.end(), nameA.begin(), [](unsigned char c) { return std::tolower(c); });
-            std::transform(nameB.begin(), nameB.end(), nameB.begin(), [](unsigned char c) { return std::tolower(c); });
-            return nameA < nameB;
-        });
+        // Edit a copy and publish it; readers holding the current version never see a half-done change
+        auto next = std::make_shared<PackCatalog>(*current);
+        next->Insert(newPack);
+        Publish(std::move(next));
 
-        packCount = static_cast<int>(RLTraining.size());
         LOG("SuiteSpot: Added custom pack: {}", pack.name);
-        // Lock releases here before SavePacksToFile
-    }
 
-    // Auto-save if we have a file path (outside the lock)
-    if (!currentFilePath.empty()) {
-        SavePacksToFile(currentFilePath);
+        // Only the change is written; training_packs.json stays as scraped. Written under
+        // the lock so a load that starts after this edit is sure to read it.
+        const std::vector<PackOverlay::Op> ops{ PackOverlay::Op::Upsert(newPack) };
+        JournalEdits(ops);
+        PackOverlay::Append(currentFilePath, ops);
     }
     return true;
 }
 
 bool TrainingPackManager::UpdatePack(const std::string& code, const TrainingEntry& updatedPack)
 {
+    TrainingEntry pack = updatedPack;
+    pack.code = CanonicalCode(updatedPack.code);
+    std::string oldCode;
     {
-        std::lock_guard<std::mutex> lock(packMutex);
-        for (auto& pack : RLTraining) {
-            if (pack.code == code) {
-                // Preserve source and update isModified
-                std::string originalSource = pack.source;
-                pack = updatedPack;
-                pack.source = originalSource;
-
-                // Mark as modified if it was a prejump pack
-                if (originalSource == "prejump") {
-                    pack.isModified = true;
-                }
+        std::lock_guard<std::mutex> lock(writeMutex);
+        const auto current = GetCatalog();
+        const int row = current->codeIndex.Find(code);
+        if (row == PackCodeIndex::kNotFound) {
+            return false;
+        }
 
-                // Sort RLTraining alphabetically by name
-                std::sort(RLTraining.begin(), RLTraining.end(), [](const TrainingEntry& a, const TrainingEntry& b) {
-                    std::string nameA = a.name;
-                    std::string nameB = b.name;
-                    std::transform(nameA.begin(), nameA.end(), nameA.begin(), [](unsigned char c) { return std::tolower(c); });
-                    std::transform(nameB.begin(), nameB.end(), nameB.begin(), [](unsigned char c) { return std::tolower(c); });
-                    return nameA < nameB;
-                });
-
-                LOG("SuiteSpot: Updated pack: {}", pack.name);
-                // Lock releases here before SavePacksToFile
-            }
+        // Preserve source and update isModified
+        const TrainingEntry& existing = current->packs[row];
+        oldCode = existing.code;
+        pack.source = existing.source;
+
+        // Mark as modified if it was a prejump pack
+        if (pack.source == "prejump") {
+            pack.isModified = true;
         }
-    }
 
-    // Auto-save outside the lock
-    if (!currentFilePath.empty()) {
-        SavePacksToFile(currentFilePath);
-        return true;
+        // The name may have changed, so Replace() re-inserts it in order
+        auto next = std::make_shared<PackCatalog>(*current);
+        next->Replace(row, pack);
+        Publish(std::move(next));
+
+        LOG("SuiteSpot: Updated pack: {}", pack.name);
+
+        // The new version replaces the old one on the next load. Upserts match by code,
+        // so a changed code also has to drop the old entry.
+        std::vector<PackOverlay::Op> ops;
+        if (pack.code != oldCode) {
+            ops.push_back(PackOverlay::Op::Delete(oldCode));
+        }
+        ops.push_back(PackOverlay::Op::Upsert(pack));
+        JournalEdits(ops);
+        PackOverlay::Append(currentFilePath, ops);
     }
-    return false;
+    return true;
 }
 
 bool TrainingPackManager::DeletePack(const std::string& code)
 {
-    std::string name;
     {
-        std::lock_guard<std::mutex> lock(packMutex);
-        auto it = std::find_if(RLTraining.begin(), RLTraining.end(),
-            [&code](const TrainingEntry& p) { return p.code == code; });
-
-        if (it != RLTraining.end()) {
-            name = it->name;
-            RLTraining.erase(it);
-            packCount = static_cast<int>(RLTraining.size());
-
-            LOG("SuiteSpot: Deleted pack: {}", name);
-        } else {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        const auto current = GetCatalog();
+        const int row = current->codeIndex.Find(code);
+        if (row == PackCodeIndex::kNotFound) {
             return false;
         }
-    }
 
-    // Auto-save outside the lock
-    if (!currentFilePath.empty()) {
-        SavePacksToFile(currentFilePath);
+        const std::string name = current->packs[row].name;
+        // The catalog's spelling, which is what the overlay matches on
+        const std::vector<PackOverlay::Op> ops{ PackOverlay::Op::Delete(current->packs[row].code) };
+        auto next = std::make_shared<PackCatalog>(*current);
+        next->Erase(row);
+        Publish(std::move(next));
+
+        LOG("SuiteSpot: Deleted pack: {}", name);
+        JournalEdits(ops);
+        PackOverlay::Append(currentFilePath, ops);
     }
     return true;
 }
@@ -602,30 +809,60 @@ bool TrainingPackManager::DeletePack(const std::string& code)
 // CATEGORIZED BAG SYSTEM
 // ============================================================================
 
-void TrainingPackManager::HealPack(const std::string& code, int shots)
+void TrainingPackManager::HealPack(const PackHarvest& harvest)
 {
-    if (code.empty() || shots <= 0) {
-        LOG("SuiteSpot: HealPack called with invalid data - code: {}, shots: {}", code, shots);
+    const std::string& code = harvest.code;
+    if (code.empty() || harvest.shots <= 0) {
+        LOG("SuiteSpot: HealPack called with invalid data - code: {}, shots: {}", code, harvest.shots);
         return;
     }
 
-    bool needsSave = false;
     bool packFound = false;
     {
-        std::lock_guard<std::mutex> lock(packMutex);
-        for (auto& pack : RLTraining) {
-            if (pack.code == code) {
-                packFound = true;
-                // Heal if shot count is missing or incorrect
-                if (pack.shotCount <= 0 || pack.shotCount != shots) {
-                    int oldCount = pack.shotCount;
-                    pack.shotCount = shots;
-                    needsSave = true;
-                    LOG("SuiteSpot: Healed pack '{}' ({}): {} -> {} shots", pack.name, code, oldCount, shots);
-                } else {
-                    LOG("SuiteSpot: Pack '{}' ({}) already has correct shot count: {}", pack.name, code, shots);
+        std::lock_guard<std::mutex> lock(writeMutex);
+        const auto current = GetCatalog();
+        const int row = current->codeIndex.Find(code);
+
+        if (row != PackCodeIndex::kNotFound) {
+            packFound = true;
+            const TrainingEntry& existing = current->packs[row];
+
+            // Text from the editor only fills blanks; scraped or user-edited text wins
+            TrainingEntry healed = existing;
+            PackOverlay::ApplyHeal(PackOverlay::Op::Heal(code, harvest.shots, harvest.creator, harvest.description), healed);
+
+            const bool shotsChanged = (existing.shotCount != healed.shotCount);
+            const bool creatorFilled = (existing.creator != healed.creator);
+            const bool notesFilled = (existing.notes != healed.notes);
+
+            if (shotsChanged || creatorFilled || notesFilled) {
+                // Replace() re-indexes the row if text was filled in; if only the shot count
+                // changed it patches that one column in place
+                auto next = std::make_shared<PackCatalog>(*current);
+                next->Replace(row, healed);
+
+                // Only what this heal filled in goes to the overlay, never the whole pack:
+                // the rest must keep following the scraped listing
+                const PackOverlay::Op op = PackOverlay::Op::Heal(code, healed.shotCount,
+                    creatorFilled ? healed.creator : std::string(), notesFilled ? healed.notes : std::string());
+
+                std::string what = shotsChanged
+                    ? std::to_string(existing.shotCount) + " -> " + std::to_string(healed.shotCount) + " shots"
+                    : std::string();
+                if (creatorFilled) what += std::string(what.empty() ? "" : ", ") + "filled creator";
+                if (notesFilled) what += std::string(what.empty() ? "" : ", ") + "filled description";
+                LOG("SuiteSpot: Healed pack '{}' ({}): {}", healed.name, code, what);
+
+                Publish(std::move(next));
+                JournalEdits({ op });
+
+                // Never write on the calling (game) thread; the flusher batches it. Queued
+                // under the lock so a load that starts after this heal waits for it.
+                if (!currentFilePath.empty()) {
+                    QueueHealWrite(currentFilePath, op);
                 }
-                break;
+            } else {
+                LOG("SuiteSpot: Pack '{}' ({}) already has correct shot count: {}", existing.name, code, harvest.shots);
             }
         }
     }
@@ -633,20 +870,136 @@ void TrainingPackManager::HealPack(const std::string& code, int shots)
     if (!packFound) {
         LOG("SuiteSpot: HealPack - Pack not found in database: {}", code);
     }
+}
+
+void TrainingPackManager::QueueHealWrite(const std::filesystem::path& filePath, const PackOverlay::Op& op)
+{
+    // Called with writeMutex held (lock order: writeMutex, then healMutex)
+    std::lock_guard<std::mutex> lock(healMutex);
+
+    // A different catalog file means the queued heals belong to the old one. They're handed
+    // to the flusher for that file rather than written here, on the game thread.
+    if (!pendingHeals.empty() && pendingHealPath != filePath) {
+        retiredHeals.push_back(HealBatch{ pendingHealPath, std::move(pendingHeals) });
+        pendingHeals.clear();
+        pendingHealSlots.clear();
+    }
+    pendingHealPath = filePath;
+
+    // Restarting the same pack ten times leaves one queued op, not ten
+    auto [slot, inserted] = pendingHealSlots.try_emplace(op.Code(), pendingHeals.size());
+    if (inserted) {
+        pendingHeals.push_back(op);
+    } else {
+        PackOverlay::Merge(pendingHeals[slot->second], op);
+    }
+    lastHealQueued = std::chrono::steady_clock::now();
 
-    if (needsSave && !currentFilePath.empty()) {
-        SavePacksToFile(currentFilePath);
-        LOG("SuiteSpot: Saved healed pack data to: {}", currentFilePath.string());
+    if (!healFlushThread.joinable()) {
+        healStop = false;
+        healFlushThread = std::thread([this]() { HealFlushLoop(); });
     }
+    healWake.notify_one();
 }
 
-TrainingEntry* TrainingPackManager::GetPackByCode(const std::string& code)
+void TrainingPackManager::HealFlushLoop()
 {
-    std::lock_guard<std::mutex> lock(packMutex);
-    for (auto& pack : RLTraining) {
-        if (pack.code == code) {
-            return &pack;
+    std::unique_lock<std::mutex> lock(healMutex);
+    while (true) {
+        healWake.wait(lock, [this]() { return healStop || !pendingHeals.empty() || !retiredHeals.empty(); });
+
+        // Hold off while heals keep arriving (e.g. restarting a pack over and over).
+        // Batches for a file that's no longer current don't wait.
+        while (!healStop && !healFlushNow && retiredHeals.empty()) {
+            const auto flushAt = lastHealQueued + kHealQuietPeriod;
+            if (std::chrono::steady_clock::now() >= flushAt) break;
+            healWake.wait_until(lock, flushAt);
+        }
+
+        std::vector<HealBatch> batches;
+        batches.swap(retiredHeals);
+        const bool quiet = healStop || healFlushNow ||
+            std::chrono::steady_clock::now() >= lastHealQueued + kHealQuietPeriod;
+        if (quiet && !pendingHeals.empty()) {
+            batches.push_back(HealBatch{ pendingHealPath, std::move(pendingHeals) });
+            pendingHeals.clear();
+            pendingHealSlots.clear();
+        }
+
+        if (!batches.empty()) {
+            healWriting = true;
+            lock.unlock();
+            for (const auto& batch : batches) {
+                if (PackOverlay::Append(batch.path, batch.ops)) {
+                    LOG("SuiteSpot: Saved {} healed pack(s) to: {}", batch.ops.size(), PackOverlay::PathFor(batch.path).string());
+                }
+            }
+            lock.lock();
+            healWriting = false;
+        }
+        if (pendingHeals.empty() && retiredHeals.empty()) {
+            healFlushNow = false;
+            healIdle.notify_all();
+            if (healStop) {
+                return;
+            }
         }
     }
-    return nullptr;
+}
+
+void TrainingPackManager::WaitForQueuedHeals()
+{
+    // Skips the quiet period but leaves the flusher running (unlike FlushPendingHeals)
+    std::unique_lock<std::mutex> lock(healMutex);
+    const auto drained = [this]() { return pendingHeals.empty() && retiredHeals.empty() && !healWriting; };
+    if (drained()) return;
+    healFlushNow = true;
+    healWake.notify_one();
+    healIdle.wait(lock, drained);
+}
+
+void TrainingPackManager::FlushPendingHeals()
+{
+    {
+        std::lock_guard<std::mutex> lock(healMutex);
+        if (!healFlushThread.joinable()) return;
+        healStop = true;
+    }
+    healWake.notify_one();
+    healFlushThread.join();
+}
+
+std::shared_ptr<const PackCatalog> TrainingPackManager::GetCatalog() const
+{
+    return catalog.load();
+}
+
+uint64_t TrainingPackManager::GetVersion() const
+{
+    return GetCatalog()->version;
+}
+
+int TrainingPackManager::GetPackCount() const
+{
+    return static_cast<int>(GetCatalog()->packs.size());
+}
+
+std::string TrainingPackManager::GetLastUpdated() const
+{
+    return GetCatalog()->lastUpdated;
+}
+
+std::shared_ptr<const std::vector<TrainingEntry>> TrainingPackManager::GetPacks() const
+{
+    return PacksOf(GetCatalog());
+}
+
+PackRef TrainingPackManager::FindPack(const std::string& code) const
+{
+    auto snapshot = GetCatalog();
+    const int row = snapshot->codeIndex.Find(code);
+    if (row == PackCodeIndex::kNotFound) {
+        return {};
+    }
+    return { PacksOf(std::move(snapshot)), row };
 }
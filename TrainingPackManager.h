@@ -1,13 +1,22 @@
 #pragma once
 #include "bakkesmod/plugin/bakkesmodplugin.h"
 #include "MapList.h"
+#include "PackCatalog.h"
+#include "PackDelta.h"
+#include "PackOverlay.h"
+#include "PackScraper.h"
 #include "logging.h"
 #include "IMGUI/json.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <filesystem>
 #include <string>
+#include <thread>
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 
 /*
  * ======================================================================================
@@ -24,32 +33,132 @@
  *
  * HOW DOES IT WORK?
  * 1. `LoadPacksFromFile()`: Reads `training_packs.json` and turns it into a list of `TrainingEntry` objects.
- * 2. `UpdateTrainingPackList()`: Runs a PowerShell script to download the latest packs from the web.
+ *    A binary snapshot next to it (`PackSnapshot`) is used instead whenever it's still current.
+ *    `LoadPacksAsync()` does the same on a worker thread; `GetLoadState()` / `GetLoadProgress()`
+ *    say how far it got, and readers keep the previously published catalog until it's done.
+ *    Your own changes (custom packs, edits, deletions, heals) are kept in a separate overlay
+ *    file (`PackOverlay`) and replayed on top; add/update/delete/heal append one line to it
+ *    instead of rewriting the catalog. Custom/edited packs that older versions stored in
+ *    `training_packs.json` itself are moved into the overlay the first time the file is read.
+ *    Heals from the training editor are applied in memory at once and queued; a background
+ *    thread writes the queue in one batch after a few quiet seconds (or on unload).
+ *    A load or merge reads the files off to the side; edits made meanwhile are kept in memory
+ *    (`EditCapture`) and replayed on the result before it's published, so none is undone.
+ * 2. `UpdateTrainingPackList()`: Downloads the latest packs from the web with `PackScraper`
+ *    (several pages at once, rate limited, failed pages retried) and writes the pack file.
+ *    An incomplete download is dropped rather than merged. Routine updates are quick syncs:
+ *    newest pages only, stopping at packs already known (`PackSyncState` decides when a full
+ *    download is needed instead). `GetUpdateStatus()` reports its progress and
+ *    `CancelUpdate()` stops it between requests. The result is merged in with `MergePacksFromFile()`: only packs that were added, removed
+ *    or changed upstream are patched (`PackDelta`), and custom/edited packs are left alone.
  * 3. `FilterAndSortPacks()`: When you type in the search bar, this function decides which packs to show.
+ *    Name/code search goes through a trigram index (`PackSearchIndex`) kept in sync with the list.
+ *    Exact code lookups (`FindPack()`) go through a hash index (`PackCodeIndex`).
+ *    Difficulty/shots/video/tag checks read packed columns (`PackColumns`), and sorted
+ *    output comes from per-column orders that are kept pre-sorted (`PackSortIndex`).
+ *    The list and all of those indexes form one immutable `PackCatalog`, published through an
+ *    atomic pointer: the UI and game hooks read it without taking a lock, and every change
+ *    publishes a new version instead of editing the current one.
  * 4. `Categorized Bags`: Organize packs into categories (Defense, Offense, etc.) for structured training rotations.
  */
 
+// Result of FilterAndSortPacks: matching rows into a pinned, immutable catalog snapshot.
+// Refiltering only rewrites `rows`; the pack data itself is never copied.
+struct PackResultView
+{
+    std::shared_ptr<const std::vector<TrainingEntry>> packs;
+    std::vector<int> rows;
+
+    size_t size() const { return rows.size(); }
+    bool empty() const { return rows.empty(); }
+    const TrainingEntry& operator[](size_t i) const { return (*packs)[rows[i]]; }
+    void clear() { packs.reset(); rows.clear(); }
+};
+
+// One pack found by code, pinned like PackResultView: the catalog snapshot it points
+// into stays alive (and unchanged) for as long as the PackRef is held.
+struct PackRef
+{
+    std::shared_ptr<const std::vector<TrainingEntry>> packs;
+    int row = PackCodeIndex::kNotFound;
+
+    explicit operator bool() const { return packs && row != PackCodeIndex::kNotFound; }
+    const TrainingEntry& operator*() const { return (*packs)[row]; }
+    const TrainingEntry* operator->() const { return &(*packs)[row]; }
+};
+
+// How many packs each filter option would match, given the rest of the current query.
+// Filled by FilterAndSortPacks in the same pass as the results.
+struct PackFacetCounts
+{
+    int total = 0;                                          // Rows in the result itself
+    int anyDifficulty = 0;                                  // Matches with difficulty set to "All"
+    int byDifficultyRank[PackColumns::kDifficultyRanks] = {};  // Indexed by PackColumns::DifficultyRank
+    std::unordered_map<std::string, int> byTag;
+};
+
+// What the training editor told us about the pack it just loaded. Shot count is always
+// trusted; the text fields only fill in blanks, they never overwrite scraped data.
+struct PackHarvest
+{
+    std::string code;
+    int shots = 0;
+    std::string creator;
+    std::string description;
+};
+
+// What the pack updater is doing, for the UI (copied out under a lock, so it's consistent)
+struct PackUpdateStatus
+{
+    PackUpdateState state = PackUpdateState::Idle;
+    PackScraper::Progress progress;
+};
+
 class TrainingPackManager
 {
 public:
+    ~TrainingPackManager();
+
     // Core data operations
     void LoadPacksFromFile(const std::filesystem::path& filePath);
-    bool IsCacheStale(const std::filesystem::path& filePath) const;
+    void LoadPacksAsync(const std::filesystem::path& filePath);  // LoadPacksFromFile on a worker thread
+    void WaitForLoad();                                           // Joins the worker, if any
+    // Patches only what changed between the catalog and an updated pack file (see PackDelta).
+    // Blocking; the updater calls it from its own thread.
+    bool MergePacksFromFile(const std::filesystem::path& filePath);
+    bool IsCacheStale(const std::filesystem::path& filePath) const;  // No update of either kind in 7 days
     std::string GetLastUpdatedTime(const std::filesystem::path& filePath) const;
     
-    // Downloads fresh data from online source
+    // Downloads fresh data from online source (PackScraper), writes it to outputPath and merges it.
+    // Empty sourceUrl = PackScraper::kDefaultSourceUrl. A quick sync (newest pages until known
+    // packs) is used unless fullSync is set or PackSyncState says the file needs a full one.
     void UpdateTrainingPackList(const std::filesystem::path& outputPath,
-                                  const std::shared_ptr<GameWrapper>& gameWrapper);
+                                  const std::shared_ptr<GameWrapper>& gameWrapper,
+                                  const std::string& sourceUrl = "",
+                                  bool fullSync = false);
+    void CancelUpdate();   // Asks a running update to stop; the catalog is left as it was
+    // Fetches pages through `get` instead of HttpWrapper (null = HttpWrapper again). With one
+    // set, no GameWrapper is needed; tests use it to replay saved pages. Set between updates.
+    void SetHttpGet(PackScraper::HttpGet get) { httpGet = std::move(get); }
+    void WaitForUpdate();  // Joins the updater, if any
+    PackUpdateStatus GetUpdateStatus() const;
 
     // Search and Sort logic
+    // tagFilters: empty = any tags; matchAllTags picks AND (true) or OR (false) across them.
+    // secondarySortColumn breaks ties in sortColumn; pass -1 for none.
+    // outFacets (optional) receives per-difficulty and per-tag counts for the same query.
     void FilterAndSortPacks(const std::string& searchText,
                           const std::string& difficultyFilter,
-                          const std::string& tagFilter,
+                          const std::vector<std::string>& tagFilters,
+                          bool matchAllTags,
                           int minShots,
                           bool videoFilter,
                           int sortColumn,
                           bool sortAscending,
-                          std::vector<TrainingEntry>& out) const;
+                          int secondarySortColumn,
+                          bool secondaryAscending,
+                          PackResultView& out,
+                          PackFacetCounts* outFacets = nullptr) const;
 
     // Helper for the UI tag filter
     void BuildAvailableTags(std::vector<std::string>& out) const;
@@ -57,25 +166,101 @@ public:
     // Management (CRUD) operations
     bool AddCustomPack(const TrainingEntry& pack);
     bool UpdatePack(const std::string& code, const TrainingEntry& updatedPack);
-    void HealPack(const std::string& code, int shots);
+    void HealPack(const PackHarvest& harvest);  // Applied now, written by the heal flusher
+    void FlushPendingHeals();                   // Writes queued heals now and stops the flusher
     bool DeletePack(const std::string& code);
     
     // Accessors
-    const std::vector<TrainingEntry>& GetPacks() const { return RLTraining; }
-    int GetPackCount() const { return packCount; }
-    std::string GetLastUpdated() const { return lastUpdated; }
+    // Never block: each returns (or reads) the current published catalog. A snapshot stays
+    // valid and unchanged for as long as the caller holds it.
+    std::shared_ptr<const PackCatalog> GetCatalog() const;
+    uint64_t GetVersion() const;  // Version of the current catalog; changes on every load/edit/heal
+    std::shared_ptr<const std::vector<TrainingEntry>> GetPacks() const;
+    int GetPackCount() const;
+    std::string GetLastUpdated() const;
     bool IsScrapingInProgress() const { return scrapingInProgress; }
-    TrainingEntry* GetPackByCode(const std::string& code);
+    CatalogLoadState GetLoadState() const { return loadState; }
+    float GetLoadProgress() const { return loadProgress; }  // 0..1 while Loading
+    PackRef FindPack(const std::string& code) const;  // Hash lookup; empty PackRef if unknown
+    std::shared_ptr<const PackDelta> GetLastDelta() const;  // What the last update changed; null before one
 
 private:
-    void SavePacksToFile(const std::filesystem::path& filePath);
+    // Only the load thread passes reportProgress; the updater reads without touching the progress bar
+    bool ReadBaseFile(const std::filesystem::path& filePath, std::vector<TrainingEntry>& packs, bool reportProgress);  // Scraped packs only, name-sorted
+    bool ReadPackFile(const std::filesystem::path& filePath, std::vector<TrainingEntry>& packs, bool reportProgress);  // Base + overlay, name-sorted
+    bool ReadBaseFileLocked(const std::filesystem::path& filePath, std::vector<TrainingEntry>& packs, bool reportProgress);  // Caller holds baseFileMutex
+    bool WriteBaseFile(const std::filesystem::path& filePath, const std::vector<TrainingEntry>& packs, const std::string& sourceUrl);
+    // Moves custom/edited rows out of the pack file into the overlay; true if `packs` changed. Caller holds baseFileMutex
+    static bool MoveUserPacksToOverlay(const std::filesystem::path& filePath, std::vector<TrainingEntry>& packs);
+    void Publish(std::shared_ptr<PackCatalog> next);  // Caller holds writeMutex
+    void JournalEdits(const std::vector<PackOverlay::Op>& ops);  // Caller holds writeMutex
 
-    std::vector<TrainingEntry> RLTraining;
-    mutable std::mutex packMutex;  // Protects RLTraining from concurrent access
-    int packCount = 0;
-    std::string lastUpdated = "Never";
-    bool scrapingInProgress = false;
+    // A catalog read from disk (load or merge) in progress. Edits published while it runs
+    // may or may not be in what it read, so they're kept and handed to Take(), to be
+    // replayed on the result before it's published.
+    class EditCapture
+    {
+    public:
+        explicit EditCapture(TrainingPackManager& owner);  // Takes writeMutex
+        ~EditCapture();                                     // Takes writeMutex unless Take() ran
+        std::vector<PackOverlay::Op> Take();                // Caller holds writeMutex
+
+    private:
+        TrainingPackManager& owner;
+        uint64_t start = 0;  // Journal position when the read began
+        bool active = true;
+    };
+    void QueueHealWrite(const std::filesystem::path& filePath, const PackOverlay::Op& op);
+    void HealFlushLoop();
+    void WaitForQueuedHeals();  // Writes the heal queue now and waits for it, flusher keeps running
+
+    // The published catalog (packs + indexes). Readers load it without locking; writers
+    // copy it, change the copy and store the copy, so a published catalog is never modified.
+    std::atomic<std::shared_ptr<const PackCatalog>> catalog{ std::make_shared<const PackCatalog>() };
+    std::mutex writeMutex;  // One writer at a time (so no edit is lost); protects currentFilePath
+    uint64_t lastVersion = 0;  // Version of the newest published catalog (writeMutex)
+    std::atomic<std::shared_ptr<const PackDelta>> lastDelta;
+    std::atomic<bool> scrapingInProgress{false};
+    std::atomic<bool> cancelUpdate{false};
+    PackScraper::HttpGet httpGet;          // Null = HttpWrapper (see SetHttpGet)
+    std::thread updateThread;              // Joined before the next update and on destruction
+    mutable std::mutex updateStatusMutex;  // Protects updateStatus
+    PackUpdateStatus updateStatus;
     std::filesystem::path currentFilePath;
+
+    // Edits published while an EditCapture is open (writeMutex); emptied when none is
+    std::vector<PackOverlay::Op> editJournal;
+    uint64_t journalStart = 0;  // Position of editJournal[0] in the stream of all edits
+    int openCaptures = 0;
+
+    // Background loading; the UI polls these every frame
+    std::atomic<CatalogLoadState> loadState{CatalogLoadState::Idle};
+    std::atomic<float> loadProgress{0.0f};
+    std::thread loadThread;
+
+    // The load thread and the updater both read the pack file (and write its snapshot), and
+    // the updater rewrites it; one at a time, so a snapshot always matches the JSON it was made from
+    std::mutex baseFileMutex;
+    std::filesystem::path migratedBasePath;  // baseFileMutex; last pack file read (so free of custom/edited rows)
+
+    // Heal queue: one coalesced op per pack, flushed after kHealQuietPeriod without new heals
+    static constexpr std::chrono::seconds kHealQuietPeriod{5};
+    std::mutex healMutex;                 // Protects everything below
+    std::condition_variable healWake;
+    std::condition_variable healIdle;     // Signalled when the queue has been written out
+    std::vector<PackOverlay::Op> pendingHeals;
+    std::unordered_map<std::string, size_t> pendingHealSlots;  // Code -> index in pendingHeals
+    std::filesystem::path pendingHealPath;
+    struct HealBatch {
+        std::filesystem::path path;
+        std::vector<PackOverlay::Op> ops;
+    };
+    std::vector<HealBatch> retiredHeals;  // Queued for a catalog file that's no longer current
+    std::chrono::steady_clock::time_point lastHealQueued;
+    bool healStop = false;
+    bool healFlushNow = false;            // Skip the quiet period (WaitForQueuedHeals)
+    bool healWriting = false;             // A batch is being appended right now
+    std::thread healFlushThread;
 };
 
 
@@ -9,6 +9,7 @@
 #include "SettingsSync.h"
 #include "ConstantsUI.h"
 #include "HelpersUI.h"
+#include "PackCode.h"
 
 #include <algorithm>
 #include <cmath>
@@ -16,28 +17,61 @@
 #include <cstdio>
 
 // Helper function for sortable column headers with visual indicators
+// Click sorts by the column (again to flip direction); Shift+click makes it the tie-breaker
 namespace {
-    bool SortableColumnHeader(const char* label, int columnIndex, int& currentSortColumn, bool& sortAscending) {
+    bool SortableColumnHeader(const char* label, int columnIndex, int& currentSortColumn, bool& sortAscending,
+                              int& secondarySortColumn, bool& secondaryAscending) {
         // Display label with sort indicator if this column is active
         // Use ASCII arrows (^ v) since Unicode triangles may not be in the font
         char buffer[256];
         if (currentSortColumn == columnIndex) {
             snprintf(buffer, sizeof(buffer), "%s %s", label, sortAscending ? "(asc)" : "(desc)");
+        } else if (secondarySortColumn == columnIndex) {
+            snprintf(buffer, sizeof(buffer), "%s %s", label, secondaryAscending ? "(2nd asc)" : "(2nd desc)");
         } else {
             snprintf(buffer, sizeof(buffer), "%s", label);
         }
 
         bool clicked = ImGui::Selectable(buffer, currentSortColumn == columnIndex, ImGuiSelectableFlags_DontClosePopups);
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Click to sort, Shift+Click to sort ties by this column");
+        }
         if (clicked) {
-            if (currentSortColumn == columnIndex) {
+            if (ImGui::GetIO().KeyShift && currentSortColumn != columnIndex) {
+                if (secondarySortColumn == columnIndex) {
+                    secondaryAscending = !secondaryAscending;
+                } else {
+                    secondarySortColumn = columnIndex;
+                    secondaryAscending = true;
+                }
+            } else if (currentSortColumn == columnIndex) {
                 sortAscending = !sortAscending;
             } else {
                 currentSortColumn = columnIndex;
                 sortAscending = true;
+                if (secondarySortColumn == columnIndex) {
+                    secondarySortColumn = -1;
+                }
             }
         }
         return clicked;
     }
+
+    // One line of the player's own history on a pack, e.g. "34/50 goals (68%), streak 3 (best 7)"
+    std::string FormatShotSummary(const PackShotSummary& s) {
+        char buffer[256];
+        int n = snprintf(buffer, sizeof(buffer), "%u/%u goals (%.0f%%), streak %u (best %u)",
+                         s.goals, s.attempts, s.successRate * 100.0, s.currentStreak, s.bestStreak);
+        if (s.goals > 0 && n > 0 && n < static_cast<int>(sizeof(buffer))) {
+            n += snprintf(buffer + n, sizeof(buffer) - n, ", median goal %.1fs (90%% within %.1fs)",
+                          s.medianTimeToGoalMs / 1000.0, s.p90TimeToGoalMs / 1000.0);
+        }
+        if (s.hardestRound >= 0 && n > 0 && n < static_cast<int>(sizeof(buffer))) {
+            snprintf(buffer + n, sizeof(buffer) - n, "\nHardest shot: #%d (%.0f%%)",
+                     s.hardestRound + 1, s.hardestRoundRate * 100.0);
+        }
+        return buffer;
+    }
 }
 
 TrainingPackUI::TrainingPackUI(SuiteSpot* plugin) : plugin_(plugin) {
@@ -78,12 +112,14 @@ void TrainingPackUI::Render() {
     ImGui::SetWindowFontScale(UI::FONT_SCALE);
 
     const auto* manager = plugin_->trainingPackMgr.get();
-    static const std::vector<TrainingEntry> emptyPacks;
-    static const std::string emptyString;
-    const auto& packs = manager ? manager->GetPacks() : emptyPacks;
-    const int packCount = manager ? manager->GetPackCount() : 0;
-    const auto& lastUpdated = manager ? manager->GetLastUpdated() : emptyString;
+    static const auto emptyCatalog = std::make_shared<const PackCatalog>();
+    // Pin one catalog snapshot for the whole frame; the count, date and list all come from it
+    const auto catalog = manager ? manager->GetCatalog() : emptyCatalog;
+    const auto& packs = catalog->packs;
+    const int packCount = static_cast<int>(packs.size());
+    const std::string& lastUpdated = catalog->lastUpdated;
     const bool scraping = manager && manager->IsScrapingInProgress();
+    const CatalogLoadState loadState = manager ? manager->GetLoadState() : CatalogLoadState::Idle;
 
     // Sync selection from Quick Picks (Single Source of Truth)
     if (plugin_->settingsSync) {
@@ -101,10 +137,46 @@ void TrainingPackUI::Render() {
     ImGui::Spacing();
 
     // Status line: pack count, last updated, auto-load, and buttons on same row
-    if (packCount > 0) {
+    if (loadState == CatalogLoadState::Loading) {
+        ImGui::TextColored(UI::TrainingPackUI::SCRAPING_STATUS_TEXT_COLOR, "Loading packs... %d%%",
+            static_cast<int>(manager->GetLoadProgress() * 100.0f));
+        if (packCount > 0) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("(showing %d previously loaded)", packCount);
+        }
+    } else if (loadState == CatalogLoadState::Failed && packCount == 0) {
+        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "Pack cache could not be read - click 'Update Pack List' to download");
+    } else if (packCount > 0) {
         ImGui::Text("Loaded: %d packs", packCount);
         ImGui::SameLine();
         ImGui::TextColored(UI::TrainingPackUI::LAST_UPDATED_TEXT_COLOR, " | Last updated: %s", lastUpdated.c_str());
+        if (loadState == CatalogLoadState::Failed) {
+            // A failed reload leaves the previous list in place
+            ImGui::SameLine();
+            ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "| Reload failed, showing the previous list");
+        }
+        // What the last "Update Pack List" changed, once it has run this session
+        if (const auto delta = manager ? manager->GetLastDelta() : nullptr) {
+            ImGui::SameLine();
+            if (delta->empty()) {
+                ImGui::TextDisabled("| No changes in last update");
+            } else {
+                ImGui::TextDisabled("| Last update: +%d new, %d changed, %d removed",
+                    (int)delta->added.size(), (int)delta->changed.size(), (int)delta->removed.size());
+                if (ImGui::IsItemHovered() && !delta->added.empty()) {
+                    ImGui::BeginTooltip();
+                    ImGui::TextUnformatted("New packs:");
+                    const size_t shown = std::min<size_t>(delta->added.size(), 10);
+                    for (size_t i = 0; i < shown; ++i) {
+                        ImGui::BulletText("%s", delta->added[i].name.c_str());
+                    }
+                    if (delta->added.size() > shown) {
+                        ImGui::TextDisabled("...and %d more", (int)(delta->added.size() - shown));
+                    }
+                    ImGui::EndTooltip();
+                }
+            }
+        }
     } else {
         ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "No packs loaded - click 'Update Pack List' to download");
     }
@@ -112,20 +184,47 @@ void TrainingPackUI::Render() {
     // Control buttons (same line with spacing)
     ImGui::SameLine(0.0f, 20.0f);
     if (scraping) {
-        ImGui::TextColored(UI::TrainingPackUI::SCRAPING_STATUS_TEXT_COLOR, "Updating...");
+        const PackUpdateStatus update = manager->GetUpdateStatus();
+        if (update.progress.pagesTotal > 0 && !update.progress.quickSync) {
+            ImGui::TextColored(UI::TrainingPackUI::SCRAPING_STATUS_TEXT_COLOR, "Updating... %d/%d pages",
+                update.progress.pagesDone, update.progress.pagesTotal);
+        } else {
+            ImGui::TextColored(UI::TrainingPackUI::SCRAPING_STATUS_TEXT_COLOR, "Updating...");
+        }
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Cancel##PackUpdate")) {
+            plugin_->trainingPackMgr->CancelUpdate();
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Stop the update; the current pack list is kept");
+        }
     } else {
         if (ImGui::Button("Update Pack List")) {
             plugin_->UpdateTrainingPackList();
         }
+        if (ImGui::BeginPopupContextItem("UpdatePackListContext")) {
+            if (ImGui::Selectable("Full resync (every page)")) {
+                plugin_->UpdateTrainingPackList(true);
+            }
+            ImGui::EndPopup();
+        }
         if (ImGui::IsItemHovered()) {
-            ImGui::SetTooltip("Download latest training packs from online source (~2-3 minutes)");
+            ImGui::SetTooltip("Download new and changed training packs from online source\n"
+                              "Right-click for a full resync (~30 seconds)");
         }
     }
 
     ImGui::SameLine();
-    if (ImGui::Button("Reload Cache")) {
+    const bool loading = (loadState == CatalogLoadState::Loading);
+    if (loading) {
+        ImGui::PushStyleVar(ImGuiStyleVar_Alpha, ImGui::GetStyle().Alpha * 0.5f);
+    }
+    if (ImGui::Button("Reload Cache") && !loading) {
         plugin_->LoadTrainingPacksFromFile(plugin_->GetTrainingPacksPath());
     }
+    if (loading) {
+        ImGui::PopStyleVar();
+    }
     if (ImGui::IsItemHovered()) {
         ImGui::SetTooltip("Reload packs from cached json file");
     }
@@ -151,7 +250,11 @@ void TrainingPackUI::Render() {
 
     // Early return if no packs loaded
     if (packs.empty()) {
-        ImGui::TextWrapped("No packs available. Click 'Scrape Packs' to download the training pack database, or add your own custom packs below.");
+        if (loadState == CatalogLoadState::Loading) {
+            ImGui::TextDisabled("Reading the training pack catalog...");
+        } else {
+            ImGui::TextWrapped("No packs available. Click 'Scrape Packs' to download the training pack database, or add your own custom packs below.");
+        }
         ImGui::End();
         return;
     }
@@ -178,10 +281,13 @@ void TrainingPackUI::Render() {
 
     bool filtersChanged = (strcmp(packSearchText, lastSearchText) != 0) ||
                           (packDifficultyFilter != lastDifficultyFilter) ||
-                          (packTagFilter != lastTagFilter) ||
+                          (packTagFilters != lastTagFilters) ||
+                          (packTagMatchAll != lastTagMatchAll) ||
                           (packMinShots != lastMinShots) ||
                           (packSortColumn != lastSortColumn) ||
                           (packSortAscending != lastSortAscending) ||
+                          (packSecondarySortColumn != lastSecondarySortColumn) ||
+                          (packSecondaryAscending != lastSecondaryAscending) ||
                           (packVideoFilter != lastVideoFilter);
 
     // Fixed widths for filter controls
@@ -201,7 +307,11 @@ void TrainingPackUI::Render() {
     if (ImGui::BeginCombo("##difficulty", packDifficultyFilter.c_str())) {
         for (int i = 0; i < IM_ARRAYSIZE(difficulties); i++) {
             bool selected = (packDifficultyFilter == difficulties[i]);
-            if (ImGui::Selectable(difficulties[i], selected)) {
+            const int count = (i == 0) ? facetCounts.anyDifficulty
+                                       : facetCounts.byDifficultyRank[PackColumns::DifficultyRank(difficulties[i])];
+            char label[64];
+            snprintf(label, sizeof(label), "%s (%d)##%s", difficulties[i], count, difficulties[i]);
+            if (ImGui::Selectable(label, selected)) {
                 packDifficultyFilter = difficulties[i];
                 filtersChanged = true;
             }
@@ -225,7 +335,8 @@ void TrainingPackUI::Render() {
     // Tag filter dropdown (second row)
     ImGui::SetNextItemWidth(UI::TrainingPackUI::TAG_FILTER_DROPDOWN_WIDTH);
 
-    bool packsSourceChanged = (lastPackCount != packCount);
+    // Any load, edit or heal publishes a new catalog version, even when the count stays the same
+    bool packsSourceChanged = (lastCatalogVersion != catalog->version);
 
     if (!tagsInitialized || packsSourceChanged) {
         if (manager) {
@@ -235,22 +346,56 @@ void TrainingPackUI::Render() {
             availableTags.push_back("All Tags");
         }
         tagsInitialized = true;
-        lastPackCount = packCount;
+        lastCatalogVersion = catalog->version;
     }
 
-    std::string displayTag = packTagFilter.empty() ? "All Tags" : packTagFilter;
+    // Multi-select: each tag toggles on/off, the Any/All switch decides how they combine
+    std::string displayTag = "All Tags";
+    if (packTagFilters.size() == 1) {
+        displayTag = packTagFilters.front();
+    } else if (packTagFilters.size() > 1) {
+        displayTag = std::to_string(packTagFilters.size()) + " tags (" + (packTagMatchAll ? "all" : "any") + ")";
+    }
     if (ImGui::BeginCombo("##tagfilter", displayTag.c_str())) {
+        if (ImGui::RadioButton("Any", !packTagMatchAll)) {
+            packTagMatchAll = false;
+            filtersChanged = true;
+        }
+        ImGui::SameLine();
+        if (ImGui::RadioButton("All", packTagMatchAll)) {
+            packTagMatchAll = true;
+            filtersChanged = true;
+        }
+        ImGui::Separator();
+
         for (const auto& tag : availableTags) {
-            bool selected = (tag == displayTag);
-            if (ImGui::Selectable(tag.c_str(), selected)) {
-                packTagFilter = (tag == "All Tags") ? "" : tag;
+            if (tag == "All Tags") {
+                if (ImGui::Selectable(tag.c_str(), packTagFilters.empty())) {
+                    packTagFilters.clear();
+                    filtersChanged = true;
+                }
+                continue;
+            }
+
+            auto it = std::find(packTagFilters.begin(), packTagFilters.end(), tag);
+            const bool selected = (it != packTagFilters.end());
+            auto countIt = facetCounts.byTag.find(tag);
+            char label[160];
+            snprintf(label, sizeof(label), "%s (%d)##%s", tag.c_str(),
+                countIt != facetCounts.byTag.end() ? countIt->second : 0, tag.c_str());
+            if (ImGui::Selectable(label, selected, ImGuiSelectableFlags_DontClosePopups)) {
+                if (selected) {
+                    packTagFilters.erase(it);
+                } else {
+                    packTagFilters.push_back(tag);
+                }
                 filtersChanged = true;
             }
         }
         ImGui::EndCombo();
     }
     if (ImGui::IsItemHovered()) {
-        ImGui::SetTooltip("Filter by tag");
+        ImGui::SetTooltip("Filter by tag (pick several, then match any or all of them)");
     }
 
     ImGui::SameLine();
@@ -267,7 +412,7 @@ void TrainingPackUI::Render() {
     if (ImGui::Button("Clear Filters")) {
         packSearchText[0] = '\0';
         packDifficultyFilter = "All";
-        packTagFilter = "";
+        packTagFilters.clear();
         packMinShots = 0;
         packMaxShots = 100;
         packVideoFilter = false;
@@ -283,20 +428,25 @@ void TrainingPackUI::Render() {
     // Rebuild filtered list only when needed
     if (filtersChanged || packsSourceChanged || !packListInitialized) {
         if (manager) {
-            manager->FilterAndSortPacks(packSearchText, packDifficultyFilter, packTagFilter,
-                packMinShots, packVideoFilter, packSortColumn, packSortAscending, filteredPacks);
+            manager->FilterAndSortPacks(packSearchText, packDifficultyFilter, packTagFilters, packTagMatchAll,
+                packMinShots, packVideoFilter, packSortColumn, packSortAscending,
+                packSecondarySortColumn, packSecondaryAscending, filteredPacks, &facetCounts);
         } else {
             filteredPacks.clear();
+            facetCounts = PackFacetCounts();
         }
 
         // Update cached filter state
         strncpy_s(lastSearchText, packSearchText, sizeof(lastSearchText) - 1);
         lastDifficultyFilter = packDifficultyFilter;
-        lastTagFilter = packTagFilter;
+        lastTagFilters = packTagFilters;
+        lastTagMatchAll = packTagMatchAll;
         lastMinShots = packMinShots;
         lastVideoFilter = packVideoFilter;
         lastSortColumn = packSortColumn;
         lastSortAscending = packSortAscending;
+        lastSecondarySortColumn = packSecondarySortColumn;
+        lastSecondaryAscending = packSecondaryAscending;
 
         // Flag to recalculate column widths
         columnWidthsDirty = true;
@@ -326,17 +476,6 @@ void TrainingPackUI::Render() {
 
     {
         bool hasSelection = !selectedPackCode.empty();
-        
-        // Find selected pack data
-        const TrainingEntry* selectedPack = nullptr;
-        if (hasSelection) {
-            for (const auto& pack : filteredPacks) {
-                if (pack.code == selectedPackCode) {
-                    selectedPack = &pack;
-                    break;
-                }
-            }
-        }
 
         // Delete (Custom only)
         if (hasSelection) {
@@ -389,7 +528,7 @@ void TrainingPackUI::Render() {
     }
 
     // Name column header (Sort ID 0)
-    if (SortableColumnHeader("Name", 0, packSortColumn, packSortAscending)) {
+    if (SortableColumnHeader("Name", 0, packSortColumn, packSortAscending, packSecondarySortColumn, packSecondaryAscending)) {
         filtersChanged = true;
     }
     ImGui::NextColumn();
@@ -401,25 +540,25 @@ void TrainingPackUI::Render() {
     }
 
     // Difficulty column header (Sort ID 2)
-    if (SortableColumnHeader("Difficulty", 2, packSortColumn, packSortAscending)) {
+    if (SortableColumnHeader("Difficulty", 2, packSortColumn, packSortAscending, packSecondarySortColumn, packSecondaryAscending)) {
         filtersChanged = true;
     }
     ImGui::NextColumn();
 
     // Shots column header (Sort ID 3)
-    if (SortableColumnHeader("Shots", 3, packSortColumn, packSortAscending)) {
+    if (SortableColumnHeader("Shots", 3, packSortColumn, packSortAscending, packSecondarySortColumn, packSecondaryAscending)) {
         filtersChanged = true;
     }
     ImGui::NextColumn();
 
     // Likes column header (Sort ID 4)
-    if (SortableColumnHeader("Likes", 4, packSortColumn, packSortAscending)) {
+    if (SortableColumnHeader("Likes", 4, packSortColumn, packSortAscending, packSecondarySortColumn, packSecondaryAscending)) {
         filtersChanged = true;
     }
     ImGui::NextColumn();
 
     // Plays column header (Sort ID 5)
-    if (SortableColumnHeader("Plays", 5, packSortColumn, packSortAscending)) {
+    if (SortableColumnHeader("Plays", 5, packSortColumn, packSortAscending, packSecondarySortColumn, packSecondaryAscending)) {
         filtersChanged = true;
     }
     ImGui::NextColumn();
@@ -481,12 +620,14 @@ void TrainingPackUI::Render() {
             }
 
             if (ImGui::BeginPopup("PackActionPopup")) {
-                const auto& trainingPacks = manager ? manager->GetPacks() : emptyPacks;
-                auto it = std::find_if(trainingPacks.begin(), trainingPacks.end(), 
-                    [&](const TrainingEntry& e) { return e.code == selectedPackCode; });
+                const PackRef it = manager ? manager->FindPack(selectedPackCode) : PackRef{};
 
-                if (it != trainingPacks.end()) {
+                if (it) {
                     ImGui::TextColored(UI::TrainingPackUI::SECTION_HEADER_TEXT_COLOR, "%s", it->name.c_str());
+                    PackShotSummary shots;
+                    if (plugin_->shotStats && plugin_->shotStats->GetSummary(selectedPackCode, shots)) {
+                        ImGui::TextDisabled("%s", FormatShotSummary(shots).c_str());
+                    }
                     ImGui::Separator();
 
                     if (ImGui::Selectable("Set Post-Match")) {
@@ -549,6 +690,11 @@ void TrainingPackUI::Render() {
                         tooltip += pack.tags[i];
                     }
                 }
+                PackShotSummary shots;
+                if (plugin_->shotStats && plugin_->shotStats->GetSummary(pack.code, shots)) {
+                    if (!tooltip.empty() && tooltip.back() != '\n') tooltip += "\n";
+                    tooltip += "Your shots: " + FormatShotSummary(shots);
+                }
                 if (!tooltip.empty()) {
                     ImVec2 mPos = ImGui::GetMousePos();
                     ImGui::SetNextWindowPos(ImVec2(mPos.x + 20, mPos.y + 20));
@@ -615,16 +761,8 @@ void TrainingPackUI::Render() {
 
 
 bool TrainingPackUI::ValidatePackCode(const char* code) const {
-    if (strlen(code) != UI::TrainingPackUI::PACK_CODE_EXPECTED_LENGTH) return false;
-    for (int i = 0; i < UI::TrainingPackUI::PACK_CODE_EXPECTED_LENGTH; i++) {
-        if (i == UI::TrainingPackUI::PACK_CODE_DASH_POSITION_1 || i == UI::TrainingPackUI::PACK_CODE_DASH_POSITION_2 || i == UI::TrainingPackUI::PACK_CODE_DASH_POSITION_3) {
-            if (code[i] != '-') return false;
-        }
-        else {
-            if (!isalnum(static_cast<unsigned char>(code[i]))) return false;
-        }
-    }
-    return true;
+    // Real codes are 16 hex digits; the input box already inserts the dashes
+    return strlen(code) == UI::TrainingPackUI::PACK_CODE_EXPECTED_LENGTH && PackCode::IsValid(code);
 }
 
 void TrainingPackUI::ClearCustomPackForm() {
@@ -873,13 +1011,8 @@ void TrainingPackUI::LoadPackImmediately(const std::string& packCode) {
     // Find pack name for logging
     std::string packName = packCode;
     const auto* manager = plugin_->trainingPackMgr.get();
-    if (manager) {
-        for (const auto& pack : manager->GetPacks()) {
-            if (pack.code == packCode) {
-                packName = pack.name;
-                break;
-            }
-        }
+    if (const PackRef pack = manager ? manager->FindPack(packCode) : PackRef{}) {
+        packName = pack->name;
     }
 
     // Execute load immediately (0 delay)
@@ -2,6 +2,7 @@
 #include "IMGUI/imgui.h"
 #include "bakkesmod/plugin/pluginwindow.h"
 #include "MapList.h"
+#include "TrainingPackManager.h"
 #include "StatusMessageUI.h"
 #include <string>
 #include <vector>
@@ -77,25 +78,32 @@ private:
 
     char packSearchText[256] = {0};
     std::string packDifficultyFilter = "All";
-    std::string packTagFilter = "";
+    std::vector<std::string> packTagFilters;  // Empty = any tags
+    bool packTagMatchAll = false;              // true: pack needs every selected tag, false: any one
     int packMinShots = 0;
     int packMaxShots = 100;
     int packSortColumn = 0;
     bool packSortAscending = true;
+    int packSecondarySortColumn = -1;  // Tie-breaker column (Shift+click a header), -1 = none
+    bool packSecondaryAscending = true;
     bool packVideoFilter = false;  // Filter for packs with video URLs
 
     char lastSearchText[256] = {0};
     std::string lastDifficultyFilter = "All";
-    std::string lastTagFilter = "";
+    std::vector<std::string> lastTagFilters;
+    bool lastTagMatchAll = false;
     int lastMinShots = 0;
     int lastSortColumn = 0;
     bool lastSortAscending = true;
+    int lastSecondarySortColumn = -1;
+    bool lastSecondaryAscending = true;
     bool lastVideoFilter = false;
 
     std::vector<std::string> availableTags;
     bool tagsInitialized = false;
-    int lastPackCount = 0;
-    std::vector<TrainingEntry> filteredPacks;
+    uint64_t lastCatalogVersion = 0;  // Catalog the tag list and results were built from
+    PackResultView filteredPacks;  // Row numbers into a pinned catalog snapshot
+    PackFacetCounts facetCounts;   // Per-option match counts shown in the filter combos
 
     // Selection state
     std::string selectedPackCode;
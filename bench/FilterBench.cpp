@@ -0,0 +1,206 @@
+#include "pch.h"
+#include "PackColumns.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+/*
+ * ======================================================================================
+ * FILTER BENCHMARK: PACK STRUCTS VS PACK COLUMNS
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * Times the browser's difficulty / shots / video / tag filters on 2k, 20k and 200k
+ * made-up packs, three ways:
+ *   old (copy)  the filter loop from before `PackColumns`: string compares on each
+ *               `TrainingEntry`, copying every match into the result
+ *   old (rows)  the same loop collecting row numbers instead, so only the data layout differs
+ *   columns     what `FilterAndSortPacks` does now: facet bitmaps from `PackColumns`,
+ *               the shots column for the range, row numbers out
+ * Search text and sorting are left out; they don't touch these fields.
+ *
+ * WHY IS IT HERE?
+ * So the gain from the columns can be measured again when they change, rather than
+ * trusted.
+ *
+ * HOW DOES IT WORK?
+ * Packs get realistic text sizes (300-500 character staff comments, notes, a video on
+ * ~30%) so the structs are as heavy as the real ones. Each query runs until 0.2 s have
+ * passed and the mean time per query is printed. The three ways must agree on the match
+ * count or the run stops.
+ *
+ * BUILDING (outside SuiteSpot.vcxproj, from the repo root in a VS x64 prompt):
+ *   cl /std:c++20 /EHsc /O2 /MD /I. /I"%BAKKESMOD%\bakkesmodsdk\include" /FIpch.h
+ *      bench\FilterBench.cpp PackColumns.cpp /Fe:FilterBench.exe
+ */
+
+std::shared_ptr<CVarManagerWrapper> _globalCvarManager;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    const char* const kDifficulties[] = { "Bronze", "Silver", "Gold", "Platinum", "Diamond", "Champion",
+                                          "Grand Champion", "Supersonic Legend", "", "Unknown" };
+
+    struct Query
+    {
+        const char* label;
+        std::string difficulty;  // "All", "Unranked" or a tier
+        std::string tag;         // Empty = any
+        int minShots;
+        bool video;
+    };
+
+    std::vector<TrainingEntry> MakePacks(size_t count)
+    {
+        std::mt19937 rng(42);
+        auto pick = [&rng](int n) { return static_cast<int>(rng() % n); };
+        auto text = [&](size_t length) {
+            std::string s(length, ' ');
+            for (auto& c : s) c = static_cast<char>('a' + pick(26));
+            return s;
+        };
+
+        std::vector<TrainingEntry> packs(count);
+        for (size_t i = 0; i < count; ++i) {
+            TrainingEntry& pack = packs[i];
+            char code[24];
+            std::snprintf(code, sizeof(code), "%04X-%04X-%04X-%04X", pick(0x10000), pick(0x10000), pick(0x10000), pick(0x10000));
+            pack.code = code;
+            pack.name = text(12 + pick(24));
+            pack.creator = text(6 + pick(10));
+            pack.creatorSlug = pack.creator;
+            pack.difficulty = kDifficulties[pick(10)];
+            for (int t = 1 + pick(6); t > 0; --t) {
+                pack.tags.push_back("Tag" + std::to_string(pick(40)));
+            }
+            pack.shotCount = 1 + pick(50);
+            pack.staffComments = text(300 + pick(200));
+            pack.notes = pick(2) ? text(100 + pick(100)) : std::string();
+            if (pick(10) < 3) pack.videoUrl = "https://www.youtube.com/watch?v=" + text(11);
+            pack.likes = pick(500);
+            pack.plays = pick(5000);
+        }
+        return packs;
+    }
+
+    bool OldMatch(const TrainingEntry& pack, const Query& q)
+    {
+        if (q.video && pack.videoUrl.empty()) return false;
+        if (q.difficulty != "All") {
+            if (q.difficulty == "Unranked") {
+                if (!pack.difficulty.empty() && pack.difficulty != "Unknown" && pack.difficulty != "All" && pack.difficulty != "Unranked") {
+                    return false;
+                }
+            } else if (pack.difficulty != q.difficulty) {
+                return false;
+            }
+        }
+        if (!q.tag.empty() && std::find(pack.tags.begin(), pack.tags.end(), q.tag) == pack.tags.end()) return false;
+        return pack.shotCount >= q.minShots;
+    }
+
+    size_t OldCopy(const std::vector<TrainingEntry>& packs, const Query& q, std::vector<TrainingEntry>& out)
+    {
+        out.clear();
+        for (const auto& pack : packs) {
+            if (OldMatch(pack, q)) out.push_back(pack);
+        }
+        return out.size();
+    }
+
+    size_t OldRows(const std::vector<TrainingEntry>& packs, const Query& q, std::vector<int>& out)
+    {
+        out.clear();
+        for (size_t row = 0; row < packs.size(); ++row) {
+            if (OldMatch(packs[row], q)) out.push_back(static_cast<int>(row));
+        }
+        return out.size();
+    }
+
+    // The facet part of TrainingPackManager::FilterAndSortPacks, without search and sort
+    size_t Columns(const PackColumns& columns, const Query& q, std::vector<int>& out)
+    {
+        PackBitmap matches(columns.size(), true);
+        if (q.video) matches &= columns.hasVideo;
+        if (q.minShots > 0) {
+            const int32_t* shotCol = columns.shots.data();
+            std::vector<uint64_t>& words = matches.Words();
+            for (size_t w = 0; w < words.size(); ++w) {
+                uint64_t keep = 0;
+                for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+                    const int bit = std::countr_zero(bits);
+                    keep |= static_cast<uint64_t>(shotCol[w * 64 + bit] >= q.minShots) << bit;
+                }
+                words[w] = keep;
+            }
+        }
+        if (q.difficulty != "All") matches &= columns.difficultyBits[PackColumns::DifficultyRank(q.difficulty)];
+        if (!q.tag.empty()) {
+            const int tagId = columns.FindTagId(q.tag);
+            if (tagId == PackColumns::kNoTag) matches.Reset(columns.size());
+            else matches &= columns.tagBits[tagId];
+        }
+
+        out.clear();
+        const std::vector<uint64_t>& words = matches.Words();
+        for (size_t w = 0; w < words.size(); ++w) {
+            for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+                out.push_back(static_cast<int>(w * 64 + std::countr_zero(bits)));
+            }
+        }
+        return out.size();
+    }
+
+    // Mean microseconds per call of `run`, repeated for at least 0.2 s
+    template <typename Run>
+    double Time(Run&& run)
+    {
+        run();  // Warm up
+        int calls = 0;
+        const auto start = Clock::now();
+        auto elapsed = Clock::duration::zero();
+        do {
+            run();
+            ++calls;
+            elapsed = Clock::now() - start;
+        } while (elapsed < std::chrono::milliseconds(200));
+        return std::chrono::duration<double, std::micro>(elapsed).count() / calls;
+    }
+}
+
+int main()
+{
+    const Query queries[] = {
+        { "Diamond, 10+ shots, video, Tag3", "Diamond", "Tag3", 10, true },
+        { "any difficulty, Tag7", "All", "Tag7", 0, false },
+        { "Unranked, 20+ shots", "Unranked", "", 20, false },
+        { "no filters", "All", "", 0, false },
+    };
+
+    std::printf("%-8s %-34s %8s %14s %14s %14s %9s\n", "packs", "query", "matches", "old copy (us)",
+                "old rows (us)", "columns (us)", "speedup");
+    for (size_t count : { 2000u, 20000u, 200000u }) {
+        const auto packs = MakePacks(count);
+        PackColumns columns;
+        columns.Build(packs);
+
+        std::vector<TrainingEntry> copies;
+        std::vector<int> rows;
+        for (const auto& q : queries) {
+            const size_t expected = OldRows(packs, q, rows);
+            if (OldCopy(packs, q, copies) != expected || Columns(columns, q, rows) != expected) {
+                std::printf("MISMATCH on \"%s\" at %zu packs\n", q.label, count);
+                return 1;
+            }
+            const double copy = Time([&] { OldCopy(packs, q, copies); });
+            const double oldRows = Time([&] { OldRows(packs, q, rows); });
+            const double cols = Time([&] { Columns(columns, q, rows); });
+            std::printf("%-8zu %-34s %8zu %14.1f %14.1f %14.1f %8.1fx\n", count, q.label, expected, copy, oldRows,
+                        cols, oldRows / cols);
+        }
+    }
+    return 0;
+}
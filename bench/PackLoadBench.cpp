@@ -0,0 +1,175 @@
+#include "pch.h"
+#include "PackJsonReader.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+/*
+ * ======================================================================================
+ * LOAD BENCHMARK: STREAMING READER VS JSON TREE
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * Loads a real `training_packs.json` with `PackJsonReader::Read()` (sax) or with the
+ * loader it replaced, which parsed the whole file into an nlohmann tree first (dom), and
+ * prints the parse time and the process's peak memory.
+ *
+ * WHY IS IT HERE?
+ * The streaming reader exists to save time and memory at startup; this shows how much.
+ *
+ * HOW DOES IT WORK?
+ * 1. One load, then the process's peak resident memory (peak working set on Windows)
+ *    is read and compared with the peak before it. Peak memory only ever goes up, so
+ *    run each mode in its own process.
+ * 2. Then 20 more loads from the same file (by now in the OS cache); the mean is the
+ *    parse time.
+ *
+ * BUILDING (outside SuiteSpot.vcxproj, from the repo root in a VS x64 prompt):
+ *   cl /std:c++20 /EHsc /O2 /MD /I. /I"%BAKKESMOD%\bakkesmodsdk\include" /FIpch.h
+ *      bench\PackLoadBench.cpp PackJsonReader.cpp /Fe:PackLoadBench.exe
+ *   PackLoadBench.exe sax DataToCopy\training_packs.json
+ *   PackLoadBench.exe dom DataToCopy\training_packs.json
+ */
+
+std::shared_ptr<CVarManagerWrapper> _globalCvarManager;
+
+namespace
+{
+    double PeakMegabytes()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters{};
+        GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+        return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+#else
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss / 1024.0;  // Kilobytes on Linux
+#endif
+    }
+
+    // The loader before PackJsonReader (from TrainingPackManager::LoadPacksFromFile), same logic
+    bool ReadWithTree(std::istream& in, std::vector<TrainingEntry>& out)
+    {
+        nlohmann::json jsonData;
+        in >> jsonData;
+
+        if (!jsonData.contains("packs") || !jsonData["packs"].is_array()) {
+            return false;
+        }
+
+        out.reserve(jsonData["packs"].size());
+
+        for (const auto& pack : jsonData["packs"]) {
+            TrainingEntry entry;
+
+            if (pack.contains("code") && pack["code"].is_string()) {
+                entry.code = pack["code"].get<std::string>();
+            }
+            if (pack.contains("name") && pack["name"].is_string()) {
+                entry.name = pack["name"].get<std::string>();
+            }
+
+            if (entry.code.empty() || entry.name.empty()) {
+                continue;
+            }
+
+            if (pack.contains("creator") && pack["creator"].is_string()) {
+                entry.creator = pack["creator"].get<std::string>();
+            }
+            if (pack.contains("creatorSlug") && pack["creatorSlug"].is_string()) {
+                entry.creatorSlug = pack["creatorSlug"].get<std::string>();
+            }
+            if (pack.contains("difficulty") && pack["difficulty"].is_string()) {
+                entry.difficulty = pack["difficulty"].get<std::string>();
+            }
+            if (pack.contains("shotCount") && pack["shotCount"].is_number()) {
+                entry.shotCount = pack["shotCount"].get<int>();
+            }
+            if (pack.contains("staffComments") && pack["staffComments"].is_string()) {
+                entry.staffComments = pack["staffComments"].get<std::string>();
+            }
+            if (pack.contains("notes") && pack["notes"].is_string()) {
+                entry.notes = pack["notes"].get<std::string>();
+            }
+            if (pack.contains("videoUrl") && pack["videoUrl"].is_string()) {
+                entry.videoUrl = pack["videoUrl"].get<std::string>();
+            }
+            if (pack.contains("likes") && pack["likes"].is_number()) {
+                entry.likes = pack["likes"].get<int>();
+            }
+            if (pack.contains("plays") && pack["plays"].is_number()) {
+                entry.plays = pack["plays"].get<int>();
+            }
+            if (pack.contains("status") && pack["status"].is_number()) {
+                entry.status = pack["status"].get<int>();
+            }
+
+            if (pack.contains("tags") && pack["tags"].is_array()) {
+                for (const auto& tag : pack["tags"]) {
+                    if (tag.is_string()) {
+                        entry.tags.push_back(tag.get<std::string>());
+                    }
+                }
+            }
+
+            if (pack.contains("source") && pack["source"].is_string()) {
+                entry.source = pack["source"].get<std::string>();
+            } else {
+                entry.source = "prejump";
+            }
+
+            if (pack.contains("isModified") && pack["isModified"].is_boolean()) {
+                entry.isModified = pack["isModified"].get<bool>();
+            }
+
+            out.push_back(std::move(entry));
+        }
+
+        return true;
+    }
+
+    bool Load(bool sax, const char* path, std::vector<TrainingEntry>& packs)
+    {
+        packs.clear();
+        std::ifstream file(path, std::ios::binary);
+        return file && (sax ? PackJsonReader::Read(file, packs) : ReadWithTree(file, packs));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || (std::strcmp(argv[1], "sax") != 0 && std::strcmp(argv[1], "dom") != 0)) {
+        std::printf("usage: PackLoadBench sax|dom [training_packs.json]\n");
+        return 1;
+    }
+    const bool sax = std::strcmp(argv[1], "sax") == 0;
+    const char* path = argc > 2 ? argv[2] : "DataToCopy/training_packs.json";
+
+    std::vector<TrainingEntry> packs;
+    const double peakBefore = PeakMegabytes();
+    if (!Load(sax, path, packs)) {
+        std::printf("Could not load %s\n", path);
+        return 1;
+    }
+    const double peakAfter = PeakMegabytes();
+
+    constexpr int kRuns = 20;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRuns; ++i) {
+        Load(sax, path, packs);
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / kRuns;
+
+    std::printf("%s: %zu packs, %.1f ms per load, peak memory %.1f MB (+%.1f MB for the load)\n",
+                argv[1], packs.size(), ms, peakAfter, peakAfter - peakBefore);
+    return 0;
+}
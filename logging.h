@@ -53,12 +53,14 @@ struct FormatWstring
 template <typename... Args>
 void LOG(std::string_view format_str, Args&&... args)
 {
+	if (!_globalCvarManager) return;  // Before onLoad, or in the tests/ programs
 	_globalCvarManager->log(std::vformat(format_str, std::make_format_args(args...)));
 }
 
 template <typename... Args>
 void LOG(std::wstring_view format_str, Args&&... args)
 {
+	if (!_globalCvarManager) return;
 	_globalCvarManager->log(std::vformat(format_str, std::make_wformat_args(args...)));
 }
 
@@ -0,0 +1,291 @@
+#include "pch.h"
+#include "PackScraper.h"
+#include "TrainingPackManager.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <thread>
+
+/*
+ * ======================================================================================
+ * PACK SCRAPER TESTS: THE UPDATER AGAINST SAVED PAGES
+ * ======================================================================================
+ *
+ * WHAT IS THIS?
+ * A small console program that runs `PackScraper` (and the manager's updater on top of
+ * it) against three saved pages of the online pack list instead of the network.
+ *
+ * WHY IS IT HERE?
+ * The scraper's rules (retry with backoff, cancel, 304 on a quick sync, never treat a
+ * missing page as deleted packs) only show up when a server misbehaves, which is hard to
+ * make happen on purpose against the real site.
+ *
+ * HOW DOES IT WORK?
+ * 1. `FixtureServer` is an `HttpGet` that answers `?page=N` with `fixtures/training-packs-page-N.html`
+ *    from a worker thread, like HttpWrapper does. Each test can make it fail or hold pages.
+ * 2. The pages hold 11 packs over 3 pages; page 2 starts with page 1's last pack, as
+ *    happens when a pack is added while someone is paging.
+ * 3. Each test prints PASS/FAIL; the exit code is the number of failed tests.
+ *
+ * BUILDING (outside SuiteSpot.vcxproj, from the repo root in a VS x64 prompt):
+ *   cl /std:c++20 /EHsc /MD /I. /I"%BAKKESMOD%\bakkesmodsdk\include" /FIpch.h
+ *      tests\PackScraperTests.cpp TrainingPackManager.cpp Pack*.cpp
+ *      /Fe:PackScraperTests.exe /link /LIBPATH:"%BAKKESMOD%\bakkesmodsdk\lib" pluginsdk.lib
+ *   PackScraperTests.exe tests\fixtures
+ * (%BAKKESMOD% is the BakkesMod folder, as in BakkesMod.props.)
+ */
+
+std::shared_ptr<CVarManagerWrapper> _globalCvarManager;  // Stays null: LOG drops messages
+
+#define CHECK(condition)                                                         \
+    do {                                                                         \
+        if (!(condition)) {                                                      \
+            std::printf("  check failed (line %d): %s\n", __LINE__, #condition); \
+            ++failedChecks;                                                      \
+        }                                                                        \
+    } while (0)
+
+namespace
+{
+    using namespace std::chrono_literals;
+    using Clock = std::chrono::steady_clock;
+
+    std::filesystem::path fixtureDir = "tests/fixtures";
+    int failedChecks = 0;
+
+    std::string ReadFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    }
+
+    // Serves the saved pages. Pages answer on their own thread; the destructor waits for them.
+    class FixtureServer
+    {
+    public:
+        std::function<int(int page, int attempt)> statusFor;  // Optional: 200 = serve the page
+        std::function<void(int page)> onRequest;              // Optional: runs before answering
+        std::chrono::milliseconds latency{2};
+
+        ~FixtureServer()
+        {
+            for (auto& worker : workers) worker.join();
+        }
+
+        PackScraper::HttpGet Get()
+        {
+            return [this](const std::string& url, const PackScraper::Headers& headers,
+                          std::function<void(int, std::string)> onDone) {
+                const int page = std::stoi(url.substr(url.rfind("page=") + 5));
+                std::lock_guard<std::mutex> lock(mutex);
+                const int attempt = ++attempts[page];
+                requests.push_back({ page, Clock::now(), headers });
+                if (onRequest) onRequest(page);
+                const int status = statusFor ? statusFor(page, attempt) : 200;
+                workers.emplace_back([this, page, status, onDone = std::move(onDone)]() {
+                    std::this_thread::sleep_for(latency);
+                    onDone(status, status == 200 ? ReadFile(fixtureDir / ("training-packs-page-" + std::to_string(page) + ".html"))
+                                                 : std::string());
+                });
+            };
+        }
+
+        struct Request
+        {
+            int page;
+            Clock::time_point at;
+            PackScraper::Headers headers;
+        };
+        std::vector<Request> Requests()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return requests;
+        }
+
+    private:
+        std::mutex mutex;
+        std::map<int, int> attempts;
+        std::vector<Request> requests;
+        std::vector<std::thread> workers;
+    };
+
+    PackScraper::Options FastOptions()
+    {
+        PackScraper::Options options;
+        options.baseUrl = "http://fixtures.local/training-packs";
+        options.requestsPerSecond = 1000.0;
+        options.firstRetryDelay = 40ms;
+        options.requestTimeout = std::chrono::seconds(2);
+        return options;
+    }
+
+    std::vector<std::string> Codes(const std::vector<TrainingEntry>& packs)
+    {
+        std::vector<std::string> codes;
+        for (const auto& pack : packs) codes.push_back(pack.code);
+        return codes;
+    }
+
+    void Pagination()
+    {
+        FixtureServer server;
+        const auto result = PackScraper::Run(FastOptions(), server.Get());
+
+        CHECK(result.Complete());
+        CHECK(result.pageCount == 3);
+        CHECK(result.pagesFetched == 3);
+        CHECK(server.Requests().size() == 3);
+        // Page order, and page 2's repeat of 776F-... is dropped
+        CHECK(result.packs.size() == 11);
+        const auto codes = Codes(result.packs);
+        CHECK(codes.front() == "DEA0-F1AF-27BD-8003");
+        CHECK(codes[3] == "776F-E2BB-2993-78D7");
+        CHECK(codes[4] == "AB99-C9E2-A0EE-533E");
+        CHECK(codes.back() == "3ACB-0F53-2775-A956");
+        // Entities decoded, tag objects flattened, scraper source set
+        CHECK(result.packs[1].tags.size() == 7 && result.packs[1].tags[0] == "Aerials");
+        CHECK(result.packs[0].source == "prejump");
+    }
+
+    void RetryWithBackoff()
+    {
+        FixtureServer server;
+        server.statusFor = [](int page, int attempt) { return page == 2 && attempt <= 2 ? 503 : 200; };
+        const auto result = PackScraper::Run(FastOptions(), server.Get());
+
+        CHECK(result.Complete());
+        CHECK(result.retries == 2);
+        CHECK(result.packs.size() == 11);
+
+        std::vector<Clock::time_point> page2;
+        for (const auto& request : server.Requests()) {
+            if (request.page == 2) page2.push_back(request.at);
+        }
+        CHECK(page2.size() == 3);
+        if (page2.size() == 3) {
+            // 40ms, then 80ms
+            CHECK(page2[1] - page2[0] >= 40ms);
+            CHECK(page2[2] - page2[1] >= 80ms);
+        }
+    }
+
+    void GivesUpAfterMaxAttempts()
+    {
+        FixtureServer server;
+        server.statusFor = [](int page, int) { return page == 3 ? 500 : 200; };
+        auto options = FastOptions();
+        options.maxAttempts = 3;
+        const auto result = PackScraper::Run(options, server.Get());
+
+        CHECK(!result.Complete());
+        CHECK(result.failedPages == std::vector<int>{ 3 });
+        CHECK(result.retries == 2);
+    }
+
+    void CancelMidRun()
+    {
+        FixtureServer server;
+        std::atomic<bool> cancel{ false };
+        server.latency = 300ms;
+        server.onRequest = [&cancel](int page) { if (page == 2) cancel = true; };
+        auto options = FastOptions();
+        options.maxConcurrent = 1;
+        options.cancel = &cancel;
+
+        const auto started = Clock::now();
+        const auto result = PackScraper::Run(options, server.Get());
+
+        CHECK(result.cancelled);
+        CHECK(!result.Complete());
+        CHECK(Clock::now() - started < 1500ms);  // Didn't wait for page 2's answer, or send page 3
+        for (const auto& request : server.Requests()) CHECK(request.page != 3);
+    }
+
+    void NotModifiedOnFirstPage()
+    {
+        FixtureServer server;
+        server.statusFor = [](int, int) { return 304; };
+        auto options = FastOptions();
+        options.isKnown = [](const TrainingEntry&) { return false; };
+        options.ifModifiedSince = "Wed, 21 Oct 2015 07:28:00 GMT";
+        const auto result = PackScraper::Run(options, server.Get());
+
+        CHECK(result.notModified);
+        CHECK(result.Complete());
+        CHECK(result.packs.empty());
+        const auto requests = server.Requests();
+        CHECK(requests.size() == 1);
+        if (!requests.empty()) {
+            CHECK(requests[0].page == 1);
+            CHECK(requests[0].headers.count("If-Modified-Since") == 1 &&
+                  requests[0].headers.at("If-Modified-Since") == options.ifModifiedSince);
+        }
+    }
+
+    void FailedPageLeavesListUnchanged()
+    {
+        const auto dir = std::filesystem::temp_directory_path() / "SuiteSpotPackScraperTests";
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        const auto packFile = dir / "training_packs.json";
+        const std::string url = "http://fixtures.local/training-packs";
+
+        TrainingPackManager manager;
+        {
+            FixtureServer server;
+            manager.SetHttpGet(server.Get());
+            manager.UpdateTrainingPackList(packFile, nullptr, url, true);
+            manager.WaitForUpdate();
+        }
+        CHECK(manager.GetUpdateStatus().state == PackUpdateState::Done);
+        CHECK(manager.GetPackCount() == 11);
+
+        const auto before = manager.GetPacks();
+        const std::string fileBefore = ReadFile(packFile);
+        {
+            FixtureServer server;
+            server.statusFor = [](int page, int) { return page == 2 ? 500 : 200; };
+            manager.SetHttpGet(server.Get());
+            manager.UpdateTrainingPackList(packFile, nullptr, url, true);
+            manager.WaitForUpdate();
+        }
+        CHECK(manager.GetUpdateStatus().state == PackUpdateState::Failed);
+        CHECK(manager.GetPacks() == before);  // Same catalog, not a copy without page 2
+        CHECK(ReadFile(packFile) == fileBefore);
+        manager.SetHttpGet(nullptr);
+
+        std::filesystem::remove_all(dir);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1) fixtureDir = argv[1];
+    if (!std::filesystem::exists(fixtureDir / "training-packs-page-1.html")) {
+        std::printf("Fixtures not found in %s (pass the folder as the first argument)\n", fixtureDir.string().c_str());
+        return 1;
+    }
+
+    const std::pair<const char*, void (*)()> tests[] = {
+        { "Pagination", Pagination },
+        { "RetryWithBackoff", RetryWithBackoff },
+        { "GivesUpAfterMaxAttempts", GivesUpAfterMaxAttempts },
+        { "CancelMidRun", CancelMidRun },
+        { "NotModifiedOnFirstPage", NotModifiedOnFirstPage },
+        { "FailedPageLeavesListUnchanged", FailedPageLeavesListUnchanged },
+    };
+
+    int failedTests = 0;
+    for (const auto& [name, test] : tests) {
+        const int failedBefore = failedChecks;
+        test();
+        const bool passed = failedChecks == failedBefore;
+        std::printf("%s %s\n", passed ? "PASS" : "FAIL", name);
+        failedTests += passed ? 0 : 1;
+    }
+    return failedTests;
+}